@@ -0,0 +1,424 @@
+#include "AlienStore.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define ALIEN_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// MSVC pozwala na intrynsyki AVX2 bez /arch, gcc i clang potrzebują atrybutu na funkcji
+#if defined(ALIEN_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+namespace {
+    const AlienType ALIEN_TYPES[ALIEN_KIND_COUNT] = {
+        { 40, 20 }, // ALIEN_GRUNT
+    };
+
+    int lowestBit(Uint32 value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(value);
+#endif
+    }
+
+    //bity życia bloku obcych zaczynającego się od wielokrotności count (count <= 16, blok nie przekracza słowa)
+    Uint32 blockBits(const Uint64* alive, int first, int count) {
+        return static_cast<Uint32>(alive[first >> 6] >> (first & 63)) & ((1u << count) - 1);
+    }
+
+#if defined(ALIEN_SIMD_X86)
+    //kernele zwracają liczbę przetworzonych obcych (pełne bloki), resztę dokańcza wersja skalarna
+
+    int moveSse2(int* x, int count, int dx, int low, int high, bool* touched) {
+        __m128i delta = _mm_set1_epi32(dx);
+        __m128i lowV = _mm_set1_epi32(low);
+        __m128i highV = _mm_set1_epi32(high);
+        __m128i any = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i a = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)), delta);
+            __m128i b = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i + 4)), delta);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(x + i), a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(x + i + 4), b);
+            any = _mm_or_si128(any, _mm_or_si128(_mm_cmplt_epi32(a, lowV), _mm_cmpgt_epi32(a, highV)));
+            any = _mm_or_si128(any, _mm_or_si128(_mm_cmplt_epi32(b, lowV), _mm_cmpgt_epi32(b, highV)));
+        }
+        *touched = _mm_movemask_epi8(any) != 0;
+        return i;
+    }
+
+    int dropSse2(int* y, const int* x, const Uint64* alive, int count, int dy,
+        int reachY, int left, int right, bool* reached) {
+        __m128i delta = _mm_set1_epi32(dy);
+        __m128i reachV = _mm_set1_epi32(reachY);
+        __m128i leftV = _mm_set1_epi32(left);
+        __m128i rightV = _mm_set1_epi32(right);
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i ya = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)), delta);
+            __m128i yb = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i + 4)), delta);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(y + i), ya);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(y + i + 4), yb);
+            __m128i xa = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+            __m128i xb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i + 4));
+            __m128i ma = _mm_and_si128(_mm_cmpgt_epi32(ya, reachV),
+                _mm_and_si128(_mm_cmpgt_epi32(xa, leftV), _mm_cmplt_epi32(xa, rightV)));
+            __m128i mb = _mm_and_si128(_mm_cmpgt_epi32(yb, reachV),
+                _mm_and_si128(_mm_cmpgt_epi32(xb, leftV), _mm_cmplt_epi32(xb, rightV)));
+            Uint32 mask = static_cast<Uint32>(_mm_movemask_ps(_mm_castsi128_ps(ma)) |
+                (_mm_movemask_ps(_mm_castsi128_ps(mb)) << 4));
+            if (mask & blockBits(alive, i, 8)) {
+                *reached = true;
+            }
+        }
+        return i;
+    }
+
+    int findFirstHitSse2(const int* x, const int* y, const Uint64* alive, int count,
+        int left, int right, int top, int bottom, int* processed) {
+        __m128i leftV = _mm_set1_epi32(left);
+        __m128i rightV = _mm_set1_epi32(right);
+        __m128i topV = _mm_set1_epi32(top);
+        __m128i bottomV = _mm_set1_epi32(bottom);
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            Uint32 bits = blockBits(alive, i, 8);
+            if (!bits) {
+                continue;
+            }
+            __m128i xa = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+            __m128i xb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i + 4));
+            __m128i ya = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+            __m128i yb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i + 4));
+            __m128i ma = _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(xa, leftV), _mm_cmplt_epi32(xa, rightV)),
+                _mm_and_si128(_mm_cmpgt_epi32(ya, topV), _mm_cmplt_epi32(ya, bottomV)));
+            __m128i mb = _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(xb, leftV), _mm_cmplt_epi32(xb, rightV)),
+                _mm_and_si128(_mm_cmpgt_epi32(yb, topV), _mm_cmplt_epi32(yb, bottomV)));
+            Uint32 mask = static_cast<Uint32>(_mm_movemask_ps(_mm_castsi128_ps(ma)) |
+                (_mm_movemask_ps(_mm_castsi128_ps(mb)) << 4)) & bits;
+            if (mask) {
+                *processed = i;
+                return i + lowestBit(mask);
+            }
+        }
+        *processed = i;
+        return -1;
+    }
+
+    TARGET_AVX2 Uint32 laneMask(__m256i mask) {
+        return static_cast<Uint32>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+    }
+
+    TARGET_AVX2 int moveAvx2(int* x, int count, int dx, int low, int high, bool* touched) {
+        __m256i delta = _mm256_set1_epi32(dx);
+        __m256i lowV = _mm256_set1_epi32(low);
+        __m256i highV = _mm256_set1_epi32(high);
+        __m256i any = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m256i a = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)), delta);
+            __m256i b = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i + 8)), delta);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(x + i), a);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(x + i + 8), b);
+            any = _mm256_or_si256(any, _mm256_or_si256(_mm256_cmpgt_epi32(lowV, a), _mm256_cmpgt_epi32(a, highV)));
+            any = _mm256_or_si256(any, _mm256_or_si256(_mm256_cmpgt_epi32(lowV, b), _mm256_cmpgt_epi32(b, highV)));
+        }
+        *touched = !_mm256_testz_si256(any, any);
+        return i;
+    }
+
+    TARGET_AVX2 int dropAvx2(int* y, const int* x, const Uint64* alive, int count, int dy,
+        int reachY, int left, int right, bool* reached) {
+        __m256i delta = _mm256_set1_epi32(dy);
+        __m256i reachV = _mm256_set1_epi32(reachY);
+        __m256i leftV = _mm256_set1_epi32(left);
+        __m256i rightV = _mm256_set1_epi32(right);
+        int i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m256i ya = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)), delta);
+            __m256i yb = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i + 8)), delta);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i), ya);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i + 8), yb);
+            __m256i xa = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+            __m256i xb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i + 8));
+            __m256i ma = _mm256_and_si256(_mm256_cmpgt_epi32(ya, reachV),
+                _mm256_and_si256(_mm256_cmpgt_epi32(xa, leftV), _mm256_cmpgt_epi32(rightV, xa)));
+            __m256i mb = _mm256_and_si256(_mm256_cmpgt_epi32(yb, reachV),
+                _mm256_and_si256(_mm256_cmpgt_epi32(xb, leftV), _mm256_cmpgt_epi32(rightV, xb)));
+            Uint32 mask = laneMask(ma) | (laneMask(mb) << 8);
+            if (mask & blockBits(alive, i, 16)) {
+                *reached = true;
+            }
+        }
+        return i;
+    }
+
+    TARGET_AVX2 int findFirstHitAvx2(const int* x, const int* y, const Uint64* alive, int count,
+        int left, int right, int top, int bottom, int* processed) {
+        __m256i leftV = _mm256_set1_epi32(left);
+        __m256i rightV = _mm256_set1_epi32(right);
+        __m256i topV = _mm256_set1_epi32(top);
+        __m256i bottomV = _mm256_set1_epi32(bottom);
+        int i = 0;
+        for (; i + 16 <= count; i += 16) {
+            Uint32 bits = blockBits(alive, i, 16);
+            if (!bits) {
+                continue;
+            }
+            __m256i xa = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+            __m256i xb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i + 8));
+            __m256i ya = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+            __m256i yb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i + 8));
+            __m256i ma = _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi32(xa, leftV), _mm256_cmpgt_epi32(rightV, xa)),
+                _mm256_and_si256(_mm256_cmpgt_epi32(ya, topV), _mm256_cmpgt_epi32(bottomV, ya)));
+            __m256i mb = _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi32(xb, leftV), _mm256_cmpgt_epi32(rightV, xb)),
+                _mm256_and_si256(_mm256_cmpgt_epi32(yb, topV), _mm256_cmpgt_epi32(bottomV, yb)));
+            Uint32 mask = (laneMask(ma) | (laneMask(mb) << 8)) & bits;
+            if (mask) {
+                *processed = i;
+                return i + lowestBit(mask);
+            }
+        }
+        *processed = i;
+        return -1;
+    }
+#endif
+}
+
+AlienStore::AlienStore()
+    : living(0), mixedKinds(false), simd(detectSimdLevel()) {
+}
+
+SimdLevel AlienStore::detectSimdLevel() {
+#if defined(ALIEN_SIMD_X86)
+    if (SDL_HasAVX2()) {
+        return SIMD_AVX2;
+    }
+    if (SDL_HasSSE2()) {
+        return SIMD_SSE2;
+    }
+#endif
+    return SIMD_SCALAR;
+}
+
+SimdLevel AlienStore::getSimdLevel() const {
+    return simd;
+}
+
+void AlienStore::setSimdLevel(SimdLevel level) {
+    simd = std::min(level, detectSimdLevel());
+}
+
+const AlienType& AlienStore::getType(int kind) {
+    return ALIEN_TYPES[kind];
+}
+
+void AlienStore::clear() {
+    xs.clear();
+    ys.clear();
+    prevXs.clear();
+    prevYs.clear();
+    kinds.clear();
+    alive.clear();
+    living = 0;
+    mixedKinds = false;
+}
+
+void AlienStore::reserve(int capacity) {
+    xs.reserve(capacity);
+    ys.reserve(capacity);
+    prevXs.reserve(capacity);
+    prevYs.reserve(capacity);
+    kinds.reserve(capacity);
+    alive.reserve((capacity + 63) / 64);
+}
+//dodaje żywego obcego i zwraca jego indeks
+int AlienStore::add(int x, int y, int kind) {
+    int index = size();
+    if (!kinds.empty() && kinds.front() != kind) {
+        mixedKinds = true;
+    }
+    xs.push_back(x);
+    ys.push_back(y);
+    prevXs.push_back(x);
+    prevYs.push_back(y);
+    kinds.push_back(static_cast<Uint8>(kind));
+    if ((index & 63) == 0) {
+        alive.push_back(0);
+    }
+    alive[index >> 6] |= 1ULL << (index & 63);
+    living++;
+    return index;
+}
+
+int AlienStore::size() const {
+    return static_cast<int>(xs.size());
+}
+
+bool AlienStore::empty() const {
+    return xs.empty();
+}
+
+int AlienStore::aliveCount() const {
+    return living;
+}
+
+bool AlienStore::isAlive(int index) const {
+    return (alive[index >> 6] >> (index & 63)) & 1;
+}
+
+void AlienStore::setAlive(int index, bool value) {
+    if (isAlive(index) == value) {
+        return;
+    }
+    alive[index >> 6] ^= 1ULL << (index & 63);
+    living += value ? 1 : -1;
+}
+
+int AlienStore::getX(int index) const {
+    return xs[index];
+}
+
+int AlienStore::getY(int index) const {
+    return ys[index];
+}
+
+int AlienStore::getWidth(int index) const {
+    return ALIEN_TYPES[kinds[index]].w;
+}
+
+int AlienStore::getHeight(int index) const {
+    return ALIEN_TYPES[kinds[index]].h;
+}
+//kernele wektorowe zakładają jeden wymiar dla całej formacji, mieszane typy idą ścieżką skalarną
+bool AlienStore::uniformKind() const {
+    return !mixedKinds && !kinds.empty();
+}
+
+bool AlienStore::moveScalar(int begin, int end, int dx, int minX, int maxX) {
+    bool touched = false;
+    for (int i = begin; i < end; ++i) {
+        xs[i] += dx;
+        if (xs[i] <= minX || xs[i] + getWidth(i) >= maxX) {
+            touched = true;
+        }
+    }
+    return touched;
+}
+
+bool AlienStore::moveAndCheckEdges(int dx, int minX, int maxX) {
+    return moveAndCheckEdges(dx, minX, maxX, 0, size());
+}
+
+bool AlienStore::moveAndCheckEdges(int dx, int minX, int maxX, int begin, int end) {
+    int done = begin;
+    bool touched = false;
+#if defined(ALIEN_SIMD_X86)
+    if (simd != SIMD_SCALAR && uniformKind()) {
+        int low = minX + 1;
+        int high = maxX - getWidth(0) - 1;
+        done += (simd == SIMD_AVX2) ? moveAvx2(xs.data() + begin, end - begin, dx, low, high, &touched)
+            : moveSse2(xs.data() + begin, end - begin, dx, low, high, &touched);
+    }
+#endif
+    return moveScalar(done, end, dx, minX, maxX) || touched;
+}
+
+bool AlienStore::dropScalar(int begin, int end, int dy, const SDL_Rect& target) {
+    bool reached = false;
+    for (int i = begin; i < end; ++i) {
+        ys[i] += dy;
+        if (isAlive(i) && ys[i] + getHeight(i) >= target.y &&
+            xs[i] < target.x + target.w && xs[i] + getWidth(i) > target.x) {
+            reached = true;
+        }
+    }
+    return reached;
+}
+
+bool AlienStore::dropAndCheckReach(int dy, const SDL_Rect& target) {
+    return dropAndCheckReach(dy, target, 0, size());
+}
+//kernel czyta bity życia od słowa begin / 64, stąd wymóg wyrównania początku zakresu
+bool AlienStore::dropAndCheckReach(int dy, const SDL_Rect& target, int begin, int end) {
+    int done = begin;
+    bool reached = false;
+#if defined(ALIEN_SIMD_X86)
+    if (simd != SIMD_SCALAR && uniformKind()) {
+        int reachY = target.y - getHeight(0) - 1;
+        int left = target.x - getWidth(0);
+        int right = target.x + target.w;
+        done += (simd == SIMD_AVX2) ? dropAvx2(ys.data() + begin, xs.data() + begin, alive.data() + begin / 64, end - begin,
+            dy, reachY, left, right, &reached)
+            : dropSse2(ys.data() + begin, xs.data() + begin, alive.data() + begin / 64, end - begin,
+            dy, reachY, left, right, &reached);
+    }
+#endif
+    return dropScalar(done, end, dy, target) || reached;
+}
+
+int AlienStore::findFirstHitScalar(int begin, int end, int x, int y, int w, int h) const {
+    for (int i = begin; i < end; ++i) {
+        if (isAlive(i) &&
+            x < xs[i] + getWidth(i) && x + w > xs[i] &&
+            y < ys[i] + getHeight(i) && y + h > ys[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+//ten sam obcy co w pętli po indeksach: kernel zwraca najniższy ustawiony bit pierwszego trafionego bloku
+int AlienStore::findFirstHit(int x, int y, int w, int h) const {
+    if (living == 0) {
+        return -1;
+    }
+    int done = 0;
+#if defined(ALIEN_SIMD_X86)
+    if (simd != SIMD_SCALAR && uniformKind()) {
+        int left = x - getWidth(0);
+        int right = x + w;
+        int top = y - getHeight(0);
+        int bottom = y + h;
+        int hit = (simd == SIMD_AVX2) ? findFirstHitAvx2(xs.data(), ys.data(), alive.data(), size(), left, right, top, bottom, &done)
+            : findFirstHitSse2(xs.data(), ys.data(), alive.data(), size(), left, right, top, bottom, &done);
+        if (hit >= 0) {
+            return hit;
+        }
+    }
+#endif
+    return findFirstHitScalar(done, size(), x, y, w, h);
+}
+
+void AlienStore::translate(int dx, int dy) {
+    for (int i = 0; i < size(); ++i) {
+        xs[i] += dx;
+        ys[i] += dy;
+    }
+}
+
+void AlienStore::storePositions() {
+    std::copy(xs.begin(), xs.end(), prevXs.begin());
+    std::copy(ys.begin(), ys.end(), prevYs.begin());
+}
+
+void AlienStore::render(RenderQueue& queue, float alpha) const {
+    SDL_Color red = { 255, 0, 0, 255 };
+    for (int i = 0; i < size(); ++i) {
+        if (isAlive(i)) {
+            SDL_Rect alienRect = { prevXs[i] + static_cast<int>((xs[i] - prevXs[i]) * alpha),
+                prevYs[i] + static_cast<int>((ys[i] - prevYs[i]) * alpha), getWidth(i), getHeight(i) };
+            queue.fillRect(alienRect, red);
+        }
+    }
+}
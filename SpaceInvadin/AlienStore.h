@@ -0,0 +1,84 @@
+#ifndef ALIEN_STORE_H
+#define ALIEN_STORE_H
+
+#include "SDL.h"
+#include "RenderQueue.h"
+#include <vector>
+
+//wymiary wspólne dla wszystkich obcych danego typu
+struct AlienType {
+    int w, h;
+};
+
+enum AlienKind {
+    ALIEN_GRUNT = 0,
+    ALIEN_KIND_COUNT
+};
+
+enum SimdLevel {
+    SIMD_SCALAR = 0,
+    SIMD_SSE2 = 1,
+    SIMD_AVX2 = 2
+};
+
+//formacja obcych jako struktura tablic: osobne ciągłe tablice x/y, bity życia po 64 w słowie
+//i typ zamiast szerokości/wysokości na obcego; gorące pętle idą kernelami SSE2/AVX2 po 8-16 obcych
+class AlienStore {
+public:
+    AlienStore();
+
+    void clear();
+    void reserve(int capacity);
+    int add(int x, int y, int kind = ALIEN_GRUNT);
+
+    int size() const;
+    bool empty() const;
+    int aliveCount() const;
+
+    bool isAlive(int index) const;
+    void setAlive(int index, bool alive);
+    int getX(int index) const;
+    int getY(int index) const;
+    int getWidth(int index) const;
+    int getHeight(int index) const;
+
+    //przesuwa wszystkich obcych (także martwych) i mówi, czy któryś dotknął krawędzi [minX, maxX]
+    bool moveAndCheckEdges(int dx, int minX, int maxX);
+    //opuszcza wszystkich obcych i mówi, czy któryś żywy sięgnął prostokąta gracza
+    bool dropAndCheckReach(int dy, const SDL_Rect& target);
+    //to samo dla obcych [begin, end); zakresy rozłączne można liczyć równolegle, begin musi być wielokrotnością 64
+    bool moveAndCheckEdges(int dx, int minX, int maxX, int begin, int end);
+    bool dropAndCheckReach(int dy, const SDL_Rect& target, int begin, int end);
+    //najniższy indeks żywego obcego nachodzącego na prostokąt albo -1
+    int findFirstHit(int x, int y, int w, int h) const;
+
+    void translate(int dx, int dy); // przesuwa całą formację bez sprawdzania krawędzi
+    void storePositions();
+    void render(RenderQueue& queue, float alpha) const;
+
+    SimdLevel getSimdLevel() const;
+    void setSimdLevel(SimdLevel level); // obniżane do tego, co obsługuje procesor
+
+    static SimdLevel detectSimdLevel();
+    static const AlienType& getType(int kind);
+
+private:
+    bool uniformKind() const;
+
+    bool moveScalar(int begin, int end, int dx, int minX, int maxX);
+    bool dropScalar(int begin, int end, int dy, const SDL_Rect& target);
+    int findFirstHitScalar(int begin, int end, int x, int y, int w, int h) const;
+
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<int> prevXs;
+    std::vector<int> prevYs;
+    std::vector<Uint8> kinds;
+    std::vector<Uint64> alive;
+    int living;
+    bool mixedKinds;
+    SimdLevel simd;
+};
+
+#endif
+#pragma once
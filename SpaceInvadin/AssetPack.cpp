@@ -0,0 +1,173 @@
+#include "AssetPack.h"
+#include "Crc32.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstring>
+
+constexpr size_t AssetPack::BLOB_ALIGNMENT;
+
+namespace {
+    const char PACK_MAGIC[4] = { 'S', 'I', 'P', 'K' };
+    const Uint16 PACK_VERSION = 1;
+    const size_t HEADER_SIZE = 4 + 2 + 2 + 4 + 4;          // magic, wersja, zarezerwowane, liczba assetów, rozmiar indeksu
+    const size_t ENTRY_FIXED_SIZE = 8 + 8 + 4 + 2;         // offset, rozmiar, CRC, długość nazwy
+
+    void putLittleEndian(std::vector<Uint8>& out, Uint64 value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<Uint8>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void putLittleEndianAt(std::vector<Uint8>& out, size_t position, Uint64 value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out[position + i] = static_cast<Uint8>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    Uint64 getLittleEndian(const Uint8* data, int bytes) {
+        Uint64 value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<Uint64>(data[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    size_t alignUp(size_t value) {
+        return (value + AssetPack::BLOB_ALIGNMENT - 1) & ~(AssetPack::BLOB_ALIGNMENT - 1);
+    }
+}
+
+AssetPack::AssetPack() {
+}
+//uszkodzone archiwum jest zamykane w całości; gra wtedy sięga po luźne pliki
+bool AssetPack::open(const std::string& filename) {
+    TRACE_ZONE("asset pack open");
+    close();
+    if (!file.open(filename)) {
+        return false;
+    }
+    if (!loadIndex()) {
+        SDL_Log("Asset pack %s is damaged, ignoring it", filename.c_str());
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::close() {
+    file.close();
+    entries.clear();
+}
+
+bool AssetPack::isOpen() const {
+    return file.isOpen();
+}
+//bloby leżą po indeksie w kolejności nazw, więc sprawdzanie CRC czyta plik sekwencyjnie
+bool AssetPack::loadIndex() {
+    const Uint8* data = file.getData();
+    size_t size = file.getSize();
+    if (size < HEADER_SIZE || std::memcmp(data, PACK_MAGIC, 4) != 0 || getLittleEndian(data + 4, 2) != PACK_VERSION) {
+        return false;
+    }
+    Uint32 count = static_cast<Uint32>(getLittleEndian(data + 8, 4));
+    Uint64 indexSize = getLittleEndian(data + 12, 4);
+    // liczba z nagłówka idzie do reserve, więc musi się zmieścić w indeksie, zanim cokolwiek zaalokuje
+    if (indexSize > size - HEADER_SIZE || count > indexSize / ENTRY_FIXED_SIZE) {
+        return false;
+    }
+
+    const Uint8* cursor = data + HEADER_SIZE;
+    const Uint8* indexEnd = cursor + indexSize;
+    std::vector<Uint32> checksums;
+    entries.reserve(count);
+    checksums.reserve(count);
+    for (Uint32 i = 0; i < count; ++i) {
+        if (static_cast<size_t>(indexEnd - cursor) < ENTRY_FIXED_SIZE) {
+            return false;
+        }
+        Uint64 offset = getLittleEndian(cursor, 8);
+        Uint64 length = getLittleEndian(cursor + 8, 8);
+        Uint32 crc = static_cast<Uint32>(getLittleEndian(cursor + 16, 4));
+        size_t nameLength = static_cast<size_t>(getLittleEndian(cursor + 20, 2));
+        cursor += ENTRY_FIXED_SIZE;
+        if (static_cast<size_t>(indexEnd - cursor) < nameLength || offset > size || length > size - offset) {
+            return false;
+        }
+        Entry entry;
+        entry.name.assign(reinterpret_cast<const char*>(cursor), nameLength);
+        entry.offset = static_cast<size_t>(offset);
+        entry.size = static_cast<size_t>(length);
+        cursor += nameLength;
+        if (!entries.empty() && entries.back().name >= entry.name) {
+            return false; // wyszukiwanie binarne wymaga ścisłego porządku
+        }
+        entries.push_back(entry);
+        checksums.push_back(crc);
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (crc32(data + entries[i].offset, entries[i].size) != checksums[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AssetPack::find(const std::string& name, const Uint8** data, size_t* size) const {
+    auto it = std::lower_bound(entries.begin(), entries.end(), name,
+        [](const Entry& entry, const std::string& key) { return entry.name < key; });
+    if (it == entries.end() || it->name != name) {
+        return false;
+    }
+    *data = file.getData() + it->offset;
+    *size = it->size;
+    return true;
+}
+
+SDL_RWops* AssetPack::openRW(const std::string& name) const {
+    const Uint8* data;
+    size_t size;
+    if (!find(name, &data, &size)) {
+        return nullptr;
+    }
+    return SDL_RWFromConstMem(data, static_cast<int>(size));
+}
+
+int AssetPack::getCount() const {
+    return static_cast<int>(entries.size());
+}
+//najpierw nagłówek i indeks z zerowymi offsetami, potem bloby; offsety są wpisywane, gdy znane jest ich miejsce
+bool encodeAssetPack(std::vector<AssetSource> assets, std::vector<Uint8>* out) {
+    std::sort(assets.begin(), assets.end(),
+        [](const AssetSource& a, const AssetSource& b) { return a.name < b.name; });
+    for (size_t i = 0; i < assets.size(); ++i) {
+        if (assets[i].name.empty() || assets[i].name.size() > 0xFFFF || (i > 0 && assets[i - 1].name == assets[i].name)) {
+            return false;
+        }
+    }
+
+    out->clear();
+    out->insert(out->end(), PACK_MAGIC, PACK_MAGIC + 4);
+    putLittleEndian(*out, PACK_VERSION, 2);
+    putLittleEndian(*out, 0, 2);
+    putLittleEndian(*out, assets.size(), 4);
+    putLittleEndian(*out, 0, 4);
+
+    std::vector<size_t> offsetPositions;
+    for (const auto& asset : assets) {
+        offsetPositions.push_back(out->size());
+        putLittleEndian(*out, 0, 8);
+        putLittleEndian(*out, asset.bytes.size(), 8);
+        putLittleEndian(*out, crc32(asset.bytes.data(), asset.bytes.size()), 4);
+        putLittleEndian(*out, asset.name.size(), 2);
+        out->insert(out->end(), asset.name.begin(), asset.name.end());
+    }
+    putLittleEndianAt(*out, 12, out->size() - HEADER_SIZE, 4);
+
+    for (size_t i = 0; i < assets.size(); ++i) {
+        out->resize(alignUp(out->size()), 0);
+        putLittleEndianAt(*out, offsetPositions[i], out->size(), 8);
+        out->insert(out->end(), assets[i].bytes.begin(), assets[i].bytes.end());
+    }
+    return true;
+}
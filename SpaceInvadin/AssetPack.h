@@ -0,0 +1,50 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include "SDL.h"
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+
+//plik do spakowania: nazwa, pod którą gra go szuka (np. "res/arial.ttf"), i zawartość
+struct AssetSource {
+    std::string name;
+    std::vector<Uint8> bytes;
+};
+
+//archiwum assetów "SIPK": nagłówek, indeks posortowany po nazwach, potem bloby wyrównane do BLOB_ALIGNMENT
+//plik jest mapowany raz przy starcie, a assety są czytane wprost z mapowania, bez kopiowania i otwierania plików
+class AssetPack {
+public:
+    static constexpr size_t BLOB_ALIGNMENT = 64;
+
+    AssetPack();
+
+    //mapuje archiwum i sprawdza indeks oraz CRC blobów; jeden przebieg od początku do końca ładuje cały plik
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const;
+
+    bool find(const std::string& name, const Uint8** data, size_t* size) const;
+    //strumień tylko do odczytu nad zmapowaną pamięcią, nullptr gdy brak assetu; ważny do close()
+    SDL_RWops* openRW(const std::string& name) const;
+    int getCount() const;
+
+private:
+    struct Entry {
+        std::string name;
+        size_t offset;
+        size_t size;
+    };
+
+    bool loadIndex();
+
+    MappedFile file;
+    std::vector<Entry> entries;
+};
+
+//składa archiwum z assetów; kolejność wejścia nie ma znaczenia, powtórzona nazwa jest błędem
+bool encodeAssetPack(std::vector<AssetSource> assets, std::vector<Uint8>* out);
+
+#endif
+#pragma once
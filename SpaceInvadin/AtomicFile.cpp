@@ -0,0 +1,91 @@
+#include "AtomicFile.h"
+#include "SDL.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    //fopen jest pod /sdl błędem C4996, MSVC wymaga fopen_s
+    FILE* openFile(const std::string& filename, const char* mode) {
+#ifdef _WIN32
+        FILE* file = nullptr;
+        return fopen_s(&file, filename.c_str(), mode) == 0 ? file : nullptr;
+#else
+        return std::fopen(filename.c_str(), mode);
+#endif
+    }
+
+    bool syncFile(FILE* file) {
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        if (std::rename(from.c_str(), to.c_str()) != 0) {
+            return false;
+        }
+        // rename trafia na dysk dopiero z wpisem katalogu
+        size_t slash = to.find_last_of('/');
+        std::string directory = (slash == std::string::npos) ? "." : to.substr(0, slash + 1);
+        int fd = ::open(directory.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            ::close(fd);
+        }
+        return true;
+#endif
+    }
+}
+
+bool writeFileAtomic(const std::string& filename, const void* data, size_t size) {
+    std::string tempName = filename + ".tmp";
+    FILE* file = openFile(tempName, "wb");
+    if (!file) {
+        SDL_Log("Failed to create %s", tempName.c_str());
+        return false;
+    }
+
+    bool written = std::fwrite(data, 1, size, file) == size && std::fflush(file) == 0 && syncFile(file);
+    written = (std::fclose(file) == 0) && written;
+    if (!written) {
+        SDL_Log("Failed to write %s", tempName.c_str());
+        std::remove(tempName.c_str());
+        return false;
+    }
+
+    if (!replaceFile(tempName, filename)) {
+        SDL_Log("Failed to replace %s", filename.c_str());
+        std::remove(tempName.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool appendFileDurable(const std::string& filename, const void* data, size_t size) {
+    FILE* file = openFile(filename, "ab");
+    if (!file) {
+        SDL_Log("Failed to open %s for append", filename.c_str());
+        return false;
+    }
+
+    bool written = std::fwrite(data, 1, size, file) == size && std::fflush(file) == 0 && syncFile(file);
+    written = (std::fclose(file) == 0) && written;
+    if (!written) {
+        SDL_Log("Failed to append to %s", filename.c_str());
+    }
+    return written;
+}
@@ -0,0 +1,13 @@
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <string>
+
+//zapisuje plik przez plik tymczasowy obok docelowego: zapis, fsync, potem rename na miejsce starego
+//po awarii w trakcie zostaje albo stary, albo nowy plik, nigdy w połowie zapisany
+bool writeFileAtomic(const std::string& filename, const void* data, size_t size);
+//dopisuje dane na koniec pliku i czeka na fsync; po awarii może zostać urwany tylko ostatni dopisek
+bool appendFileDurable(const std::string& filename, const void* data, size_t size);
+
+#endif
+#pragma once
@@ -0,0 +1,266 @@
+#include "AutosaveJournal.h"
+#include "AtomicFile.h"
+#include "Crc32.h"
+#include "MappedFile.h"
+#include "SaveGame.h"
+#include "Trace.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace {
+    const char JOURNAL_MAGIC[4] = { 'S', 'I', 'J', 'L' };
+    const Uint16 JOURNAL_VERSION = 1;
+    const size_t HEADER_SIZE = 4 + 2 + 2 + 4;
+
+    enum RecordType {
+        RECORD_LEVEL = 1,       // poziom; formacja wraca do ustawienia z resetAliens
+        RECORD_FORMATION = 2,   // pozycja pierwszego obcego, prędkość i kierunek formacji
+        RECORD_ALIEN_KILLED = 3,
+        RECORD_PLAYER = 4       // pozycja i zdrowie gracza
+    };
+
+    void putVarint(std::vector<Uint8>& out, Uint32 value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<Uint8>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<Uint8>(value));
+    }
+
+    void putSigned(std::vector<Uint8>& out, int value) {
+        putVarint(out, (static_cast<Uint32>(value) << 1) ^ static_cast<Uint32>(value >> 31));
+    }
+
+    bool getVarint(const Uint8*& cursor, const Uint8* end, Uint32* value) {
+        *value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (cursor == end) {
+                return false;
+            }
+            Uint8 byte = *cursor++;
+            *value |= static_cast<Uint32>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool getSigned(const Uint8*& cursor, const Uint8* end, int* value) {
+        Uint32 encoded;
+        if (!getVarint(cursor, end, &encoded)) {
+            return false;
+        }
+        *value = static_cast<int>((encoded >> 1) ^ (0u - (encoded & 1)));
+        return true;
+    }
+
+    Uint32 getLittleEndian32(const Uint8* data) {
+        return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<Uint32>(data[3]) << 24);
+    }
+
+    bool applyRecords(const Uint8* cursor, const Uint8* end, Simulation* sim) {
+        while (cursor < end) {
+            Uint8 type = *cursor++;
+            if (type == RECORD_LEVEL) {
+                Uint32 level;
+                if (!getVarint(cursor, end, &level) || level < 1) {
+                    return false;
+                }
+                sim->level = static_cast<int>(level);
+                sim->resetAliens();
+            }
+            else if (type == RECORD_FORMATION) {
+                int x, y, speed, direction;
+                if (!getSigned(cursor, end, &x) || !getSigned(cursor, end, &y) ||
+                    !getSigned(cursor, end, &speed) || !getSigned(cursor, end, &direction) ||
+                    sim->aliens.empty() || (direction != 1 && direction != -1)) {
+                    return false;
+                }
+                sim->aliens.translate(x - sim->aliens.getX(0), y - sim->aliens.getY(0));
+                sim->alienSpeed = speed;
+                sim->alienDirection = direction;
+            }
+            else if (type == RECORD_ALIEN_KILLED) {
+                Uint32 index;
+                if (!getVarint(cursor, end, &index) || index >= static_cast<Uint32>(sim->aliens.size())) {
+                    return false;
+                }
+                sim->aliens.setAlive(static_cast<int>(index), false);
+            }
+            else if (type == RECORD_PLAYER) {
+                int x, y, health;
+                if (!getSigned(cursor, end, &x) || !getSigned(cursor, end, &y) || !getSigned(cursor, end, &health)) {
+                    return false;
+                }
+                sim->player.x = x;
+                sim->player.y = y;
+                sim->playerHealth = health;
+            }
+            else {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+AutosaveJournal::AutosaveJournal()
+    : level(0), formationX(0), formationY(0), alienSpeed(0), alienDirection(0),
+    playerX(0), playerY(0), playerHealth(0) {
+}
+
+void AutosaveJournal::begin(const Simulation& sim) {
+    level = sim.level;
+    formationX = sim.aliens.empty() ? 0 : sim.aliens.getX(0);
+    formationY = sim.aliens.empty() ? 0 : sim.aliens.getY(0);
+    alienSpeed = sim.alienSpeed;
+    alienDirection = sim.alienDirection;
+    playerX = sim.player.x;
+    playerY = sim.player.y;
+    playerHealth = sim.playerHealth;
+    alive.assign(sim.aliens.size(), false);
+    for (int i = 0; i < sim.aliens.size(); ++i) {
+        alive[i] = sim.aliens.isAlive(i);
+    }
+}
+//zapisuje tylko to, co zmieniło się od poprzedniego wpisu; nowy poziom idzie pierwszy, bo odbudowuje formację
+bool AutosaveJournal::record(const Simulation& sim, std::vector<Uint8>* entry) {
+    std::vector<Uint8> records;
+
+    if (sim.level != level) {
+        records.push_back(RECORD_LEVEL);
+        putVarint(records, static_cast<Uint32>(sim.level));
+        level = sim.level;
+        alive.assign(sim.aliens.size(), true);
+        formationX = INT_MIN; // pozycja po resetAliens jest nieznana, formacja zapisze się na pewno
+    }
+
+    if (!sim.aliens.empty()) {
+        int x = sim.aliens.getX(0);
+        int y = sim.aliens.getY(0);
+        if (x != formationX || y != formationY || sim.alienSpeed != alienSpeed || sim.alienDirection != alienDirection) {
+            records.push_back(RECORD_FORMATION);
+            putSigned(records, x);
+            putSigned(records, y);
+            putSigned(records, sim.alienSpeed);
+            putSigned(records, sim.alienDirection);
+            formationX = x;
+            formationY = y;
+            alienSpeed = sim.alienSpeed;
+            alienDirection = sim.alienDirection;
+        }
+    }
+
+    int count = std::min(sim.aliens.size(), static_cast<int>(alive.size()));
+    for (int i = 0; i < count; ++i) {
+        if (alive[i] && !sim.aliens.isAlive(i)) {
+            records.push_back(RECORD_ALIEN_KILLED);
+            putVarint(records, static_cast<Uint32>(i));
+            alive[i] = false;
+        }
+    }
+
+    if (sim.player.x != playerX || sim.player.y != playerY || sim.playerHealth != playerHealth) {
+        records.push_back(RECORD_PLAYER);
+        putSigned(records, sim.player.x);
+        putSigned(records, sim.player.y);
+        putSigned(records, sim.playerHealth);
+        playerX = sim.player.x;
+        playerY = sim.player.y;
+        playerHealth = sim.playerHealth;
+    }
+
+    if (records.empty()) {
+        return false;
+    }
+    entry->clear();
+    putVarint(*entry, static_cast<Uint32>(records.size()));
+    entry->insert(entry->end(), records.begin(), records.end());
+    Uint32 crc = crc32(records.data(), records.size());
+    for (int i = 0; i < 4; ++i) {
+        entry->push_back(static_cast<Uint8>((crc >> (8 * i)) & 0xFF));
+    }
+    return true;
+}
+
+std::vector<Uint8> AutosaveJournal::header(Uint32 snapshotCrc) {
+    std::vector<Uint8> out(JOURNAL_MAGIC, JOURNAL_MAGIC + sizeof(JOURNAL_MAGIC));
+    out.push_back(static_cast<Uint8>(JOURNAL_VERSION & 0xFF));
+    out.push_back(static_cast<Uint8>(JOURNAL_VERSION >> 8));
+    out.push_back(0);
+    out.push_back(0);
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<Uint8>((snapshotCrc >> (8 * i)) & 0xFF));
+    }
+    return out;
+}
+
+int AutosaveJournal::replay(const Uint8* data, size_t size, Uint32 snapshotCrc, Simulation* sim) {
+    if (size < HEADER_SIZE || std::memcmp(data, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+        (data[4] | (data[5] << 8)) != JOURNAL_VERSION) {
+        SDL_Log("Not an autosave journal");
+        return -1;
+    }
+    if (getLittleEndian32(data + 8) != snapshotCrc) {
+        return -1; // dziennik starszego zapisu, nowszy pełny zapis już go zawiera
+    }
+
+    const Uint8* cursor = data + HEADER_SIZE;
+    const Uint8* end = data + size;
+    int entries = 0;
+    while (cursor < end) {
+        Uint32 length;
+        if (!getVarint(cursor, end, &length) || length + 4 > static_cast<size_t>(end - cursor)) {
+            break; // urwany ostatni wpis
+        }
+        if (crc32(cursor, length) != getLittleEndian32(cursor + length) || !applyRecords(cursor, cursor + length, sim)) {
+            break;
+        }
+        cursor += length + 4;
+        entries++;
+    }
+    if (cursor < end) {
+        SDL_Log("Autosave journal: ignored %u damaged bytes after entry %d", static_cast<unsigned>(end - cursor), entries);
+    }
+    return entries;
+}
+//mapuje oba pliki tylko na czas wczytania
+bool AutosaveJournal::load(const std::string& snapshotFile, const std::string& journalFile, Simulation* sim) {
+    TRACE_ZONE("load save");
+    MappedFile snapshot;
+    if (!snapshot.open(snapshotFile)) {
+        SDL_Log("Failed to open save file: %s", snapshotFile.c_str());
+        return false;
+    }
+    if (!decodeSave(snapshot.getData(), snapshot.getSize(), sim)) {
+        SDL_Log("Rejected save file: %s", snapshotFile.c_str());
+        return false;
+    }
+
+    MappedFile journal;
+    if (journal.open(journalFile)) {
+        int entries = replay(journal.getData(), journal.getSize(), crc32(snapshot.getData(), snapshot.getSize()), sim);
+        if (entries > 0) {
+            SDL_Log("Recovered %d autosave entries from %s", entries, journalFile.c_str());
+        }
+    }
+    return true;
+}
+//load zamyka mapowania przed podmianą plików, Windows nie pozwala zastąpić zmapowanego pliku
+bool AutosaveJournal::compact(const std::string& snapshotFile, const std::string& journalFile) {
+    TRACE_ZONE("journal compact");
+    Simulation state;
+    if (!load(snapshotFile, journalFile, &state)) {
+        return false;
+    }
+    std::vector<Uint8> bytes;
+    encodeSave(state, &bytes);
+
+    if (!writeFileAtomic(snapshotFile, bytes.data(), bytes.size())) {
+        return false;
+    }
+    std::vector<Uint8> emptyJournal = header(crc32(bytes.data(), bytes.size()));
+    return writeFileAtomic(journalFile, emptyJournal.data(), emptyJournal.size());
+}
@@ -0,0 +1,40 @@
+#ifndef AUTOSAVE_JOURNAL_H
+#define AUTOSAVE_JOURNAL_H
+
+#include "Simulation.h"
+#include <string>
+#include <vector>
+
+//dziennik autozapisu dopisywany za pełnym zapisem gry: nagłówek z CRC pliku zapisu, do którego należy,
+//potem wpisy (długość, rekordy zmian od poprzedniego wpisu, CRC-32 wpisu)
+//rekordy: nowy poziom, pozycja formacji obcych, zestrzeleni obcy, pozycja i zdrowie gracza
+//urwany albo uszkodzony ostatni wpis po awarii jest pomijany, wcześniejsze zostają
+class AutosaveJournal {
+public:
+    AutosaveJournal();
+
+    void begin(const Simulation& sim); // stan, od którego liczone są kolejne zmiany
+    bool record(const Simulation& sim, std::vector<Uint8>* entry); // false, gdy nic się nie zmieniło
+
+    static std::vector<Uint8> header(Uint32 snapshotCrc);
+    //nakłada poprawne wpisy na sim; -1 gdy dziennik należy do innego zapisu, inaczej liczba wpisów
+    static int replay(const Uint8* data, size_t size, Uint32 snapshotCrc, Simulation* sim);
+    //wczytuje pełny zapis i nakłada na niego dziennik, jeśli do niego należy; false gdy zapis jest nieczytelny
+    static bool load(const std::string& snapshotFile, const std::string& journalFile, Simulation* sim);
+    //odtwarza zapis z dziennikiem i zapisuje wynik jako nowy zapis z pustym dziennikiem
+    static bool compact(const std::string& snapshotFile, const std::string& journalFile);
+
+private:
+    int level;
+    int formationX;
+    int formationY;
+    int alienSpeed;
+    int alienDirection;
+    int playerX;
+    int playerY;
+    int playerHealth;
+    std::vector<bool> alive;
+};
+
+#endif
+#pragma once
@@ -0,0 +1,337 @@
+#include "BulletPool.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define BULLET_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// MSVC pozwala na intrynsyki AVX2 bez /arch, gcc i clang potrzebują atrybutu na funkcji
+#if defined(BULLET_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+constexpr int BulletPool::DEFAULT_CAPACITY;
+
+namespace {
+    const int COLUMN_COUNT = 6; // x, y, w, h, prevX, prevY
+    const int STORAGE_FACTOR = 2; // tablice mieszczą tyle pojemności, nadmiar to zapas na recykling najstarszych
+
+    //kopiuje tablicę do nowej o dokładnie podanej rezerwie, żeby zmniejszenie pojemności oddało pamięć
+    template <typename T>
+    void reserveExactly(std::vector<T>& values, int capacity) {
+        std::vector<T> storage;
+        storage.reserve(capacity);
+        storage.insert(storage.end(), values.begin(), values.end());
+        values.swap(storage);
+    }
+
+    template <typename T>
+    void dropFront(std::vector<T>& values, int count) {
+        values.erase(values.begin(), values.begin() + count);
+    }
+
+#if defined(BULLET_SIMD_X86)
+    //kernele zwracają liczbę przetworzonych pocisków (pełne bloki), resztę dokańcza wersja skalarna
+
+    //maska "poza ekranem" z dwóch wektorów po 4 zamieniona na 8 bajtów gasi bajty aktywności bez rozgałęzień
+    int advanceSse2(int* y, Uint8* active, int count, int dy, int minY, int maxY) {
+        __m128i delta = _mm_set1_epi32(dy);
+        __m128i minV = _mm_set1_epi32(minY);
+        __m128i maxV = _mm_set1_epi32(maxY);
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i a = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)), delta);
+            __m128i b = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i + 4)), delta);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(y + i), a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(y + i + 4), b);
+            __m128i outA = _mm_or_si128(_mm_cmplt_epi32(a, minV), _mm_cmpgt_epi32(a, maxV));
+            __m128i outB = _mm_or_si128(_mm_cmplt_epi32(b, minV), _mm_cmpgt_epi32(b, maxV));
+            __m128i out = _mm_packs_epi16(_mm_packs_epi32(outA, outB), _mm_setzero_si128());
+            __m128i flags = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(active + i));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(active + i), _mm_andnot_si128(out, flags));
+        }
+        return i;
+    }
+
+    TARGET_AVX2 int advanceAvx2(int* y, Uint8* active, int count, int dy, int minY, int maxY) {
+        __m256i delta = _mm256_set1_epi32(dy);
+        __m256i minV = _mm256_set1_epi32(minY);
+        __m256i maxV = _mm256_set1_epi32(maxY);
+        int i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m256i a = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)), delta);
+            __m256i b = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i + 8)), delta);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i), a);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i + 8), b);
+            __m256i outA = _mm256_or_si256(_mm256_cmpgt_epi32(minV, a), _mm256_cmpgt_epi32(a, maxV));
+            __m256i outB = _mm256_or_si256(_mm256_cmpgt_epi32(minV, b), _mm256_cmpgt_epi32(b, maxV));
+            // packs działa w połówkach 128-bitowych, permute przywraca kolejność pocisków
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(outA, outB), 0xD8);
+            __m128i out = _mm_packs_epi16(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1));
+            __m128i flags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(active + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(active + i), _mm_andnot_si128(out, flags));
+        }
+        return i;
+    }
+
+    //dla każdej 8-bitowej maski aktywnych: indeksy aktywnych pasów po kolei i ich liczba
+    struct CompactTable {
+        int lanes[256][8];
+        int counts[256];
+
+        CompactTable() {
+            for (int mask = 0; mask < 256; ++mask) {
+                int count = 0;
+                for (int lane = 0; lane < 8; ++lane) {
+                    lanes[mask][lane] = 0;
+                    if (mask & (1 << lane)) {
+                        lanes[mask][count++] = lane;
+                    }
+                }
+                counts[mask] = count;
+            }
+        }
+    };
+
+    const CompactTable& compactTable() {
+        static const CompactTable table;
+        return table;
+    }
+
+    //zsuwa bloki po 8: permutacja z tablicy ściąga aktywne pasy na początek i zapisuje cały wektor pod write;
+    //write <= read, więc zapis nadpisuje tylko już wczytane pozycje, a nadmiarowe pasy nadpisze następny blok
+    TARGET_AVX2 int compactAvx2(int* const* columns, Uint8* active, int read, int count, int* write) {
+        const CompactTable& table = compactTable();
+        __m128i zero = _mm_setzero_si128();
+        __m128i ones = _mm_set1_epi8(1);
+        int w = *write;
+        int i = read;
+        for (; i + 8 <= count; i += 8) {
+            __m128i flags = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(active + i));
+            int keep = ~_mm_movemask_epi8(_mm_cmpeq_epi8(flags, zero)) & 0xFF;
+            if (keep == 0) {
+                continue;
+            }
+            __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.lanes[keep]));
+            for (int c = 0; c < COLUMN_COUNT; ++c) {
+                __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns[c] + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(columns[c] + w), _mm256_permutevar8x32_epi32(values, lanes));
+            }
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(active + w), ones);
+            w += table.counts[keep];
+        }
+        *write = w;
+        return i;
+    }
+#endif
+}
+
+BulletPool::BulletPool(int capacity, OverflowPolicy policy)
+    : head(0), capacity(0), dropped(0), policy(policy), simd(AlienStore::detectSimdLevel()) {
+    setCapacity(capacity);
+}
+//zmienia pojemność poza grą; przy zmniejszeniu zostają najstarsze żywe pociski
+void BulletPool::setCapacity(int newCapacity) {
+    newCapacity = std::max(newCapacity, 1);
+    if (newCapacity == capacity) {
+        return;
+    }
+    compact();
+    rebase();
+    if (size() > newCapacity) {
+        xs.resize(newCapacity);
+        ys.resize(newCapacity);
+        ws.resize(newCapacity);
+        hs.resize(newCapacity);
+        prevXs.resize(newCapacity);
+        prevYs.resize(newCapacity);
+        active.resize(newCapacity);
+    }
+    int storage = newCapacity * STORAGE_FACTOR;
+    reserveExactly(xs, storage);
+    reserveExactly(ys, storage);
+    reserveExactly(ws, storage);
+    reserveExactly(hs, storage);
+    reserveExactly(prevXs, storage);
+    reserveExactly(prevYs, storage);
+    reserveExactly(active, storage);
+    capacity = newCapacity;
+}
+
+void BulletPool::setOverflowPolicy(OverflowPolicy newPolicy) {
+    policy = newPolicy;
+}
+
+SimdLevel BulletPool::getSimdLevel() const {
+    return simd;
+}
+
+void BulletPool::setSimdLevel(SimdLevel level) {
+    simd = std::min(level, AlienStore::detectSimdLevel());
+}
+//O(1) poza przepełnieniem: dopiero pełna pula zsuwa zgaszone pociski albo zwalnia najstarszy,
+//co przesuwa tylko head; przeniesienie na początek tablic przypada raz na capacity odzyskanych pocisków
+int BulletPool::spawn(int x, int y, int w, int h) {
+    if (size() == capacity) {
+        compact();
+        if (size() == capacity) {
+            dropped++;
+            if (policy == OVERFLOW_DROP_NEWEST) {
+                return -1;
+            }
+            head++;
+        }
+    }
+    if (static_cast<int>(xs.size()) == capacity * STORAGE_FACTOR) {
+        rebase();
+    }
+    xs.push_back(x);
+    ys.push_back(y);
+    ws.push_back(w);
+    hs.push_back(h);
+    prevXs.push_back(x);
+    prevYs.push_back(y);
+    active.push_back(1);
+    return size() - 1;
+}
+
+void BulletPool::rebase() {
+    if (head == 0) {
+        return;
+    }
+    dropFront(xs, head);
+    dropFront(ys, head);
+    dropFront(ws, head);
+    dropFront(hs, head);
+    dropFront(prevXs, head);
+    dropFront(prevYs, head);
+    dropFront(active, head);
+    head = 0;
+}
+
+int BulletPool::compactScalar(int read, int write) {
+    for (int count = static_cast<int>(xs.size()); read < count; ++read) {
+        if (!active[read]) {
+            continue;
+        }
+        xs[write] = xs[read];
+        ys[write] = ys[read];
+        ws[write] = ws[read];
+        hs[write] = hs[read];
+        prevXs[write] = prevXs[read];
+        prevYs[write] = prevYs[read];
+        active[write] = 1;
+        write++;
+    }
+    return write;
+}
+//jeden przebieg po wszystkich tablicach naraz; początek bez zgaszonych pocisków zostaje na miejscu, head też
+void BulletPool::compact() {
+    int read = static_cast<int>(std::find(active.begin() + head, active.end(), 0) - active.begin());
+    int write = read;
+#if defined(BULLET_SIMD_X86)
+    if (simd == SIMD_AVX2) {
+        int* columns[COLUMN_COUNT] = { xs.data(), ys.data(), ws.data(), hs.data(), prevXs.data(), prevYs.data() };
+        read = compactAvx2(columns, active.data(), read, static_cast<int>(xs.size()), &write);
+    }
+#endif
+    write = compactScalar(read, write);
+
+    xs.resize(write);
+    ys.resize(write);
+    ws.resize(write);
+    hs.resize(write);
+    prevXs.resize(write);
+    prevYs.resize(write);
+    active.resize(write);
+}
+
+void BulletPool::clear() {
+    xs.clear();
+    ys.clear();
+    ws.clear();
+    hs.clear();
+    prevXs.clear();
+    prevYs.clear();
+    active.clear();
+    head = 0;
+}
+
+int BulletPool::size() const {
+    return static_cast<int>(xs.size()) - head;
+}
+
+int BulletPool::getCapacity() const {
+    return capacity;
+}
+
+int BulletPool::getDropped() const {
+    return dropped;
+}
+
+bool BulletPool::isActive(int index) const {
+    return active[head + index] != 0;
+}
+
+void BulletPool::deactivate(int index) {
+    active[head + index] = 0;
+}
+
+int BulletPool::getX(int index) const {
+    return xs[head + index];
+}
+
+int BulletPool::getY(int index) const {
+    return ys[head + index];
+}
+
+int BulletPool::getWidth(int index) const {
+    return ws[head + index];
+}
+
+int BulletPool::getHeight(int index) const {
+    return hs[head + index];
+}
+
+void BulletPool::advanceScalar(int begin, int end, int dy, int minY, int maxY) {
+    for (int i = begin; i < end; ++i) {
+        ys[i] += dy;
+        if (ys[i] < minY || ys[i] > maxY) {
+            active[i] = 0;
+        }
+    }
+}
+
+void BulletPool::advance(int dy, int minY, int maxY, int begin, int end) {
+    begin += head;
+    end += head;
+    int done = begin;
+#if defined(BULLET_SIMD_X86)
+    if (simd == SIMD_AVX2) {
+        done += advanceAvx2(ys.data() + begin, active.data() + begin, end - begin, dy, minY, maxY);
+    }
+    else if (simd == SIMD_SSE2) {
+        done += advanceSse2(ys.data() + begin, active.data() + begin, end - begin, dy, minY, maxY);
+    }
+#endif
+    advanceScalar(done, end, dy, minY, maxY);
+}
+
+void BulletPool::storePositions() {
+    std::copy(xs.begin() + head, xs.end(), prevXs.begin() + head);
+    std::copy(ys.begin() + head, ys.end(), prevYs.begin() + head);
+}
+
+void BulletPool::render(RenderQueue& queue, float alpha) const {
+    SDL_Color white = { 255, 255, 255, 255 };
+    for (int i = head; i < static_cast<int>(xs.size()); ++i) {
+        if (active[i]) {
+            SDL_Rect bulletRect = { prevXs[i] + static_cast<int>((xs[i] - prevXs[i]) * alpha),
+                prevYs[i] + static_cast<int>((ys[i] - prevYs[i]) * alpha), ws[i], hs[i] };
+            queue.fillRect(bulletRect, white);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef BULLET_POOL_H
+#define BULLET_POOL_H
+
+#include "SDL.h"
+#include "AlienStore.h"
+#include "RenderQueue.h"
+#include <vector>
+
+//pula pocisków o stałej pojemności jako struktura tablic: osobne ciągłe tablice x/y/w/h, pozycji sprzed ticka
+//i bajtów aktywności; pamięć rezerwowana raz, spawn dopisuje na koniec, despawn to deactivate,
+//a compact() raz na tick zsuwa aktywne pociski w miejscu, zachowując kolejność wystrzału (od niej zależą kolizje)
+//ruch z odcinaniem za ekranem i zsuwanie idą kernelami SSE2/AVX2 (poziom jak w AlienStore)
+//tablice mają zapas drugiej pojemności: OVERFLOW_RECYCLE_OLDEST tylko przesuwa początek puli (head),
+//a pociski wracają na początek tablic dopiero, gdy zapas się skończy, czyli raz na capacity odzyskanych
+class BulletPool {
+public:
+    enum OverflowPolicy {
+        OVERFLOW_DROP_NEWEST = 0,   // pełna pula ignoruje nowy pocisk
+        OVERFLOW_RECYCLE_OLDEST = 1 // pełna pula usuwa najstarszy żywy pocisk
+    };
+
+    static constexpr int DEFAULT_CAPACITY = 256;
+
+    explicit BulletPool(int capacity = DEFAULT_CAPACITY, OverflowPolicy policy = OVERFLOW_DROP_NEWEST);
+
+    void setCapacity(int capacity); // jedyne miejsce, które alokuje
+    void setOverflowPolicy(OverflowPolicy policy);
+
+    int spawn(int x, int y, int w, int h); // indeks nowego pocisku albo -1, gdy polityka go odrzuciła
+    void compact();
+    void clear();
+
+    int size() const; // razem z pociskami zgaszonymi od ostatniego compact()
+    int getCapacity() const;
+    int getDropped() const;
+
+    bool isActive(int index) const;
+    void deactivate(int index);
+    int getX(int index) const;
+    int getY(int index) const;
+    int getWidth(int index) const;
+    int getHeight(int index) const;
+
+    //przesuwa pociski [begin, end) o dy (także zgaszone) i gasi te, których y wyszło poza [minY, maxY];
+    //zakresy rozłączne można liczyć równolegle
+    void advance(int dy, int minY, int maxY, int begin, int end);
+
+    void storePositions();
+    void render(RenderQueue& queue, float alpha) const;
+
+    SimdLevel getSimdLevel() const;
+    void setSimdLevel(SimdLevel level); // obniżane do tego, co obsługuje procesor
+
+private:
+    void advanceScalar(int begin, int end, int dy, int minY, int maxY);
+    int compactScalar(int read, int write);
+    void rebase(); // przenosi pociski z [head, koniec) na początek tablic
+
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<int> ws;
+    std::vector<int> hs;
+    std::vector<int> prevXs;
+    std::vector<int> prevYs;
+    std::vector<Uint8> active; // bajt na pocisk, żeby wątki gaszące rozłączne zakresy nie dzieliły słów
+    int head;     // indeks 0 puli w tablicach; wcześniejsze sloty zwolnił recykling najstarszych
+    int capacity;
+    int dropped;
+    OverflowPolicy policy;
+    SimdLevel simd;
+};
+
+#endif
+#pragma once
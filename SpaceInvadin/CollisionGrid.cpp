@@ -0,0 +1,85 @@
+#include "CollisionGrid.h"
+#include <algorithm>
+
+CollisionGrid::CollisionGrid(int worldWidth, int worldHeight, int cellSize)
+    : cellSize(cellSize),
+    columns((worldWidth + cellSize - 1) / cellSize),
+    rows((worldHeight + cellSize - 1) / cellSize),
+    cellStart(columns * rows + 1, 0),
+    cellFill(columns * rows, 0) {
+}
+//obiekty poza planszą trafiają do skrajnych komórek, tak samo przy budowie i przy zapytaniu
+int CollisionGrid::clampCell(int value, int cellCount) const {
+    int cell = (value >= 0) ? value / cellSize : -1;
+    return std::min(std::max(cell, 0), cellCount - 1);
+}
+
+void CollisionGrid::cellRange(int x, int y, int w, int h, int* minCellX, int* minCellY, int* maxCellX, int* maxCellY) const {
+    *minCellX = clampCell(x, columns);
+    *minCellY = clampCell(y, rows);
+    *maxCellX = clampCell(x + w - 1, columns);
+    *maxCellY = clampCell(y + h - 1, rows);
+}
+//dwa przejścia: zliczenie wpisów na komórkę, potem wypełnienie; wpisy w komórce są rosnące po indeksie obcego
+void CollisionGrid::build(const AlienStore& aliens) {
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+
+    int minX, minY, maxX, maxY;
+    for (int index = 0; index < aliens.size(); ++index) {
+        if (!aliens.isAlive(index)) {
+            continue;
+        }
+        cellRange(aliens.getX(index), aliens.getY(index), aliens.getWidth(index), aliens.getHeight(index), &minX, &minY, &maxX, &maxY);
+        for (int cy = minY; cy <= maxY; ++cy) {
+            for (int cx = minX; cx <= maxX; ++cx) {
+                cellStart[cy * columns + cx + 1]++;
+            }
+        }
+    }
+
+    for (int i = 0; i < columns * rows; ++i) {
+        cellStart[i + 1] += cellStart[i];
+        cellFill[i] = cellStart[i];
+    }
+    cellItems.resize(cellStart[columns * rows]);
+
+    for (int index = 0; index < aliens.size(); ++index) {
+        if (!aliens.isAlive(index)) {
+            continue;
+        }
+        Entry entry = { index, aliens.getX(index), aliens.getY(index), 0, 0 };
+        entry.right = entry.left + aliens.getWidth(index);
+        entry.bottom = entry.top + aliens.getHeight(index);
+        cellRange(entry.left, entry.top, entry.right - entry.left, entry.bottom - entry.top, &minX, &minY, &maxX, &maxY);
+        for (int cy = minY; cy <= maxY; ++cy) {
+            for (int cx = minX; cx <= maxX; ++cx) {
+                cellItems[cellFill[cy * columns + cx]++] = entry;
+            }
+        }
+    }
+}
+//zwraca najniższy indeks żywego obcego nachodzącego na prostokąt albo -1
+//(tego samego obcego wybrałaby pętla po wszystkich obcych w kolejności)
+int CollisionGrid::findFirstHit(const AlienStore& aliens, int x, int y, int w, int h) const {
+    int best = -1;
+    int minX, minY, maxX, maxY;
+    cellRange(x, y, w, h, &minX, &minY, &maxX, &maxY);
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            int cell = cy * columns + cx;
+            for (int i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                const Entry& entry = cellItems[i];
+                if (best != -1 && entry.index >= best) {
+                    break; // wpisy są posortowane, dalej w tej komórce nie będzie lepszego
+                }
+                // obcy mógł zginąć od wcześniejszego pocisku w tym samym ticku
+                if (x < entry.right && x + w > entry.left &&
+                    y < entry.bottom && y + h > entry.top && aliens.isAlive(entry.index)) {
+                    best = entry.index;
+                    break;
+                }
+            }
+        }
+    }
+    return best;
+}
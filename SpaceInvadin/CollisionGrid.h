@@ -0,0 +1,35 @@
+#ifndef COLLISION_GRID_H
+#define COLLISION_GRID_H
+
+#include "AlienStore.h"
+#include <vector>
+
+//równomierna siatka nad planszą 800x600: każda komórka trzyma indeksy żywych obcych, którzy na nią nachodzą
+//budowana od nowa w każdym ticku sortowaniem przez zliczanie, więc w stanie ustalonym nie alokuje
+class CollisionGrid {
+public:
+    CollisionGrid(int worldWidth, int worldHeight, int cellSize);
+
+    void build(const AlienStore& aliens);
+    int findFirstHit(const AlienStore& aliens, int x, int y, int w, int h) const;
+
+private:
+    //kopia prostokąta obcego w komórce, zapytanie nie sięga do tablic formacji dopóki nie trafi
+    struct Entry {
+        int index;
+        int left, top, right, bottom;
+    };
+
+    void cellRange(int x, int y, int w, int h, int* minCellX, int* minCellY, int* maxCellX, int* maxCellY) const;
+    int clampCell(int value, int cellCount) const;
+
+    int cellSize;
+    int columns;
+    int rows;
+    std::vector<int> cellStart; // początek listy komórki w cellItems, ostatni element = liczba wpisów
+    std::vector<Entry> cellItems;
+    std::vector<int> cellFill;
+};
+
+#endif
+#pragma once
@@ -0,0 +1,27 @@
+#include "Crc32.h"
+
+namespace {
+    struct Crc32Table {
+        Uint32 entries[256];
+
+        Crc32Table() {
+            for (Uint32 i = 0; i < 256; ++i) {
+                Uint32 value = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+                }
+                entries[i] = value;
+            }
+        }
+    };
+}
+
+Uint32 crc32(const void* data, size_t size, Uint32 crc) {
+    static const Crc32Table table;
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table.entries[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
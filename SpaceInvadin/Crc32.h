@@ -0,0 +1,10 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include "SDL.h"
+
+//CRC-32 (wielomian IEEE, jak w zip/png); kolejne kawałki liczy się podając poprzedni wynik jako crc
+Uint32 crc32(const void* data, size_t size, Uint32 crc = 0);
+
+#endif
+#pragma once
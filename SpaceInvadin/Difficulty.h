@@ -0,0 +1,15 @@
+#ifndef DIFFICULTY_H
+#define DIFFICULTY_H
+
+//ustawienia trudności czytane przez symulację; domyślne wartości to gra, jaką zna gracz
+//nie są częścią stanu gry (zapisu, nagrania ani sumy kontrolnej), ustawia je ten, kto tworzy symulację
+struct Difficulty {
+    int earlyRows = 3;        // rzędy obcych na poziomach 1-2
+    int middleRows = 5;       // na poziomach 3-4
+    int lateRows = 6;         // od poziomu 5
+    int baseAlienSpeed = 1;   // prędkość formacji na poziomie 1, co dwa poziomy rośnie o 1
+    int alienFirePercent = 5; // szansa na strzał obcych w jednym ticku
+};
+
+#endif
+#pragma once
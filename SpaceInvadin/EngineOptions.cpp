@@ -0,0 +1,72 @@
+#include "EngineOptions.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+constexpr int EngineOptions::MIN_TICK_RATE;
+constexpr int EngineOptions::MAX_TICK_RATE;
+//czyta argumenty, przy nieznanym argumencie wypisuje pomoc i zwraca false
+bool parseEngineOptions(int argc, char* argv[], EngineOptions* options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--headless") == 0) {
+            options->headless = true;
+        }
+        else if (std::strcmp(arg, "--frames") == 0 && i + 1 < argc) {
+            options->maxFrames = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(arg, "--tick-rate") == 0 && i + 1 < argc) {
+            options->tickRate = std::atoi(argv[++i]);
+            if (options->tickRate < EngineOptions::MIN_TICK_RATE || options->tickRate > EngineOptions::MAX_TICK_RATE) {
+                std::cerr << "Tick rate must be between " << EngineOptions::MIN_TICK_RATE << " and "
+                    << EngineOptions::MAX_TICK_RATE << " Hz" << std::endl;
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--seed") == 0 && i + 1 < argc) {
+            options->seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--record") == 0 && i + 1 < argc) {
+            options->recordPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--replay") == 0 && i + 1 < argc) {
+            options->replayPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--import-save") == 0 && i + 1 < argc) {
+            options->importSavePath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--export-save") == 0 && i + 1 < argc) {
+            options->exportSavePath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--log-level") == 0 && i + 1 < argc) {
+            if (!parseLogLevel(argv[++i], &options->logLevel)) {
+                std::cerr << "Log level must be trace, debug, info, warn or error" << std::endl;
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--log-file") == 0 && i + 1 < argc) {
+            options->logPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--no-render-thread") == 0) {
+            options->renderThread = false;
+        }
+        else if (std::strcmp(arg, "--profile-csv") == 0 && i + 1 < argc) {
+            options->profileCsvPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--trace") == 0 && i + 1 < argc) {
+            options->tracePath = argv[++i];
+        }
+        else {
+            std::cerr << "Unknown argument: " << arg << "\n"
+                << "Usage: SpaceInvadin [--headless] [--frames N] [--tick-rate HZ] [--seed N] [--record FILE | --replay FILE]"
+                << " [--import-save FILE] [--export-save FILE] [--log-level LEVEL] [--log-file FILE]"
+                << " [--profile-csv FILE] [--trace FILE] [--no-render-thread]" << std::endl;
+            return false;
+        }
+    }
+    if (!options->recordPath.empty() && !options->replayPath.empty()) {
+        std::cerr << "--record and --replay cannot be used together" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,33 @@
+#ifndef ENGINE_OPTIONS_H
+#define ENGINE_OPTIONS_H
+
+#include "SDL.h"
+#include "Log.h"
+#include <string>
+
+//ustawienia uruchomienia gry przekazywane z linii poleceń
+struct EngineOptions {
+    bool headless = false;  // bez okna i rasteryzacji, rysowanie idzie do NullRenderer
+    int maxFrames = 0;      // po tylu klatkach gra się kończy, 0 = bez limitu
+    int tickRate = 60;      // ile razy na sekundę liczona jest symulacja; tempo gry od niej nie zależy
+    Uint64 seed = 0;        // seed generatora losowego, 0 = z zegara
+    std::string recordPath; // nagrywa wejście z każdego ticka do tego pliku
+    std::string replayPath; // odtwarza nagranie zamiast czytać klawiaturę
+    std::string importSavePath; // zaczyna od tekstowego zapisu zamiast save.dat
+    std::string exportSavePath; // przy zapisie gry zapisuje też kopię tekstową
+    LogLevel logLevel = LEVEL_INFO; // wpisy poniżej tego poziomu są odrzucane przed kolejką
+    std::string logPath;    // log do pliku zamiast na konsolę
+    std::string profileCsvPath; // czasy faz każdej klatki do pliku CSV
+    std::string tracePath;  // nagrywa strefy od startu; F4 zatrzymuje i zapisuje ślad do tego pliku
+    bool renderThread = true; // pętla gry na osobnym wątku, a flush i present na głównym; bez okna wszystko idzie w pętli gry
+
+    //poniżej MIN_TICK_RATE pocisk gracza przelatywałby w jednym ticku przez obcego (20 px + 10 px pocisku),
+    //powyżej MAX_TICK_RATE tick byłby krótszy niż rozdzielczość zegara i pętla nie nadążałaby z tickami
+    static constexpr int MIN_TICK_RATE = 30;
+    static constexpr int MAX_TICK_RATE = 1000;
+};
+
+bool parseEngineOptions(int argc, char* argv[], EngineOptions* options);
+
+#endif
+#pragma once
@@ -0,0 +1,121 @@
+#include "FramePipeline.h"
+#include "Trace.h"
+#include <chrono>
+
+constexpr int FramePipeline::FRESH;
+constexpr int FramePipeline::PUMP_INTERVAL_MS;
+
+FramePipeline::FramePipeline()
+    : writeIndex(0), readIndex(1), middle(2), renderer(nullptr), clearColor{ 0, 0, 0, 255 },
+    running(false), publishedFrames(0), presentedFrames(0), lastFlushTicks(0), lastPresentTicks(0), firstPresentCounter(0) {
+}
+
+void FramePipeline::start(Renderer* target, const SDL_Color& color) {
+    renderer = target;
+    clearColor = color;
+    for (auto& queue : queues) {
+        queue.clear();
+    }
+    writeIndex = 0;
+    readIndex = 1;
+    middle.store(2);
+    publishedFrames = 0;
+    presentedFrames.store(0);
+    running.store(true);
+}
+
+void FramePipeline::close() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running.store(false);
+    }
+    wake.notify_all();
+}
+
+bool FramePipeline::isRunning() const {
+    return running.load();
+}
+
+RenderQueue& FramePipeline::getWriteQueue() {
+    return queues[writeIndex];
+}
+//czeka, aż poprzednia klatka będzie na ekranie: gra liczy następną klatkę w czasie rysowania tej, ale nie dalej,
+//więc opóźnienie względem rysowania w pętli gry rośnie najwyżej o jedną klatkę
+void FramePipeline::publish() {
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return presentedFrames.load() >= publishedFrames || !running.load(); });
+    }
+    int previous = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+    writeIndex = previous & ~FRESH;
+    queues[writeIndex].clear(); // nieodebrana klatka (tylko przy zamykaniu) przepada
+    publishedFrames++;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_all();
+}
+
+Uint64 FramePipeline::getLastFlushTicks() const {
+    return lastFlushTicks.load(std::memory_order_relaxed);
+}
+
+Uint64 FramePipeline::getLastPresentTicks() const {
+    return lastPresentTicks.load(std::memory_order_relaxed);
+}
+
+Uint64 FramePipeline::getFirstPresentCounter() const {
+    return firstPresentCounter.load();
+}
+
+bool FramePipeline::takeFresh() {
+    if (!(middle.load(std::memory_order_acquire) & FRESH)) {
+        return false;
+    }
+    int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+    readIndex = previous & ~FRESH;
+    return true;
+}
+//czekanie ma limit czasu, żeby zdarzenia okna były zbierane także wtedy, gdy gra długo nie publikuje
+void FramePipeline::presentLoop(const std::function<void()>& pump) {
+    while (true) {
+        pump();
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait_for(lock, std::chrono::milliseconds(PUMP_INTERVAL_MS),
+                [this] { return (middle.load() & FRESH) || !running.load(); });
+        }
+        if (takeFresh()) {
+            present();
+        }
+        else if (!running.load()) {
+            return;
+        }
+    }
+}
+
+void FramePipeline::present() {
+    Uint64 start = SDL_GetPerformanceCounter();
+    {
+        TRACE_ZONE("flush");
+        renderer->clear(clearColor);
+        queues[readIndex].flush(*renderer);
+    }
+    Uint64 flushed = SDL_GetPerformanceCounter();
+    {
+        TRACE_ZONE("present");
+        renderer->present();
+    }
+    Uint64 presented = SDL_GetPerformanceCounter();
+
+    lastFlushTicks.store(flushed - start, std::memory_order_relaxed);
+    lastPresentTicks.store(presented - flushed, std::memory_order_relaxed);
+    if (firstPresentCounter.load() == 0) {
+        firstPresentCounter.store(presented);
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        presentedFrames.fetch_add(1);
+    }
+    wake.notify_all();
+}
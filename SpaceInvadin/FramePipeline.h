@@ -0,0 +1,67 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include "SDL.h"
+#include "RenderQueue.h"
+#include "Renderer.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+//przekazanie klatek z wątku gry do wątku rysującego: gra wypełnia kolejkę klatki i ją publikuje,
+//a wątek rysujący robi clear, flush i present, więc tick następnej klatki liczy się w czasie rysowania poprzedniej
+//SDL_Renderer wolno używać tylko na wątku, który go utworzył, dlatego rysuje wątek główny (presentLoop),
+//a pętla gry działa na osobnym wątku; zdarzenia SDL też zbiera wątek główny między klatkami
+//kolejki krążą w potrójnym buforze: wymiana kolejek to atomowa zamiana indeksów, bez blokad,
+//ale publish usypia grę na zmiennej warunkowej, aż poprzednia klatka zostanie pokazana,
+//więc gra wyprzedza ekran najwyżej o klatkę i nie kręci się na pusto, gdy present czeka na vsync
+class FramePipeline {
+public:
+    FramePipeline();
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    void start(Renderer* renderer, const SDL_Color& clearColor);
+    void close(); // wątek gry skończył: presentLoop rysuje jeszcze opublikowaną klatkę i wraca
+    bool isRunning() const;
+
+    RenderQueue& getWriteQueue(); // wątek gry: kolejka następnej klatki, ważna do publish
+    void publish();
+
+    //wątek, który utworzył renderer: rysuje opublikowane klatki do close, a przed każdym czekaniem woła pump
+    void presentLoop(const std::function<void()>& pump);
+
+    //czasy z ostatniej narysowanej klatki w tickach SDL_GetPerformanceCounter, do profilera wątku gry
+    Uint64 getLastFlushTicks() const;
+    Uint64 getLastPresentTicks() const;
+    Uint64 getFirstPresentCounter() const; // 0 = jeszcze nic nie pokazano
+
+private:
+    static constexpr int FRESH = 4; // bit w middle: opublikowana klatka czeka na odbiór
+    static constexpr int PUMP_INTERVAL_MS = 5; // tak często wątek rysujący zbiera zdarzenia, gdy nie ma klatki
+
+    bool takeFresh(); // zamienia rysowaną kolejkę na opublikowaną, jeśli jest nowa
+    void present();
+
+    RenderQueue queues[3];
+    int writeIndex;          // tylko wątek gry
+    int readIndex;           // tylko wątek rysujący
+    std::atomic<int> middle; // indeks opublikowanej kolejki | FRESH
+
+    Renderer* renderer;
+    SDL_Color clearColor;
+    std::atomic<bool> running;
+    Uint64 publishedFrames;              // tylko wątek gry
+    std::atomic<Uint64> presentedFrames;
+    std::atomic<Uint64> lastFlushTicks;
+    std::atomic<Uint64> lastPresentTicks;
+    std::atomic<Uint64> firstPresentCounter;
+
+    //tylko do usypiania: wątek rysujący czeka na klatkę, a gra na odbiór poprzedniej; same kolejki idą przez middle
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+};
+
+#endif
+#pragma once
@@ -1,473 +1,752 @@
 #include "GameEngine.h"
+#include "SdlRenderer.h"
+#include "NullRenderer.h"
+#include "SaveGame.h"
+#include "Crc32.h"
 #include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <future>
+#include <sstream>
+#include <thread>
 
 constexpr int SCREEN_WIDTH = 800;
 constexpr int SCREEN_HEIGHT = 600;
-
-GameEngine::GameEngine()
-    : window(nullptr), renderer(nullptr), running(true), gameOver(false),
-    spacePressed(false), showHelp(false), exitRequested(false),
-    player(SCREEN_WIDTH / 2 - 25, SCREEN_HEIGHT - 60, 50, 20, 5),
-    playerHealth(3), level(1), alienSpeed(1), alienDirection(1) {
-    std::srand(std::time(nullptr));
+const SDL_Color COLOR_BLACK = { 0, 0, 0, 255 };
+const SDL_Color COLOR_WHITE = { 255, 255, 255, 255 };
+const SDL_Color COLOR_RED = { 255, 0, 0, 255 };
+const char* const SAVE_FILE = "save.dat";
+const char* const JOURNAL_FILE = "save.journal";
+const char* const LEADERBOARD_FILE = "leaderboard.dat";
+const char* const LEADERBOARD_INDEX_FILE = "leaderboard.idx";
+const char* const DEFAULT_TRACE_FILE = "trace.json";
+const char* const ASSET_PACK_FILE = "assets.pak";
+const char* const FONT_ASSET = "res/arial.ttf";
+const double TRACE_WINDOW_SECONDS = 10.0;
+
+GameEngine::GameEngine(const EngineOptions& options, Uint64 processStart)
+    : options(options),
+    welcomeText(textAtlas, "Press Enter to Start", COLOR_WHITE),
+    helpTitleText(textAtlas, "Help Screen", COLOR_WHITE),
+    helpMoveText(textAtlas, "Arrow Keys: Move", COLOR_WHITE),
+    helpShootText(textAtlas, "Space: Shoot", COLOR_WHITE),
+    helpResumeText(textAtlas, "Press F1/Esc (my f1 key doesnt work) to Resume", COLOR_WHITE),
+    exitPromptText(textAtlas, "Exit? Press Y to save and exit, N to cancel", COLOR_WHITE),
+    gameOverText(textAtlas, "Game Over!", COLOR_RED),
+    scoreText(textAtlas, "", COLOR_RED),
+    highScoreText(textAtlas, "", COLOR_RED),
+    levelText(textAtlas, "", COLOR_WHITE),
+    rankText(textAtlas, "", COLOR_WHITE),
+    topTitleText(textAtlas, "Top 10", COLOR_WHITE),
+    topTexts(Leaderboard::TOP_SIZE, Text(textAtlas, "", COLOR_WHITE)),
+    profilerTexts(PHASE_COUNT, Text(textAtlas, "", COLOR_WHITE)),
+    shownLevel(-1), shownScore(-1), shownHighScore(-1),
+    running(true), scene(SCENE_NONE), sceneBeforeExitPrompt(SCENE_PLAYING),
+    frameCount(0), lastCounter(0), accumulator(0), alpha(0.0f), showProfiler(false),
+    journaling(false), lastAutosaveTick(0), journalBytes(0),
+    highScore(0),
+    processStart(processStart != 0 ? processStart : SDL_GetPerformanceCounter()),
+    initializeStart(0), initializedCounter(0), firstFrameCounter(0) {
 }
 
 GameEngine::~GameEngine() {}
 //inicjalizuje assety i stan zapisu jeśli istnieje
+//pliki i wypiekanie znaków nie potrzebują okna, więc idą na wątkach startowych, a główny w tym czasie otwiera okno;
+//zależności: znaki czekają na archiwum assetów, stan gry i tablica wyników są niezależne, upload atlasu czeka na okno i znaki
 bool GameEngine::initialize() {
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        std::cerr << "SDL could not initialize! SDL Error: " << SDL_GetError() << std::endl;
-        return false;
+    initializeStart = SDL_GetPerformanceCounter();
+    Tracer::instance().setThreadName("main");
+    if (!options.tracePath.empty()) {
+        Tracer::instance().setRecording(true);
     }
+    TRACE_ZONE("initialize");
 
-    if (TTF_Init() == -1) {
+    if (TTF_Init() == -1) { // nie wymaga SDL_Init, a znaki wypieka już wątek startowy
         SDL_Log("SDL_ttf could not initialize: %s", TTF_GetError());
         return false;
     }
 
-    window = SDL_CreateWindow("Space Invader", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
-    if (!window) {
-        std::cerr << "Window could not be created! SDL Error: " << SDL_GetError() << std::endl;
+    std::shared_future<bool> assetsOpened = std::async(std::launch::async, [this] { return openAssets(); }).share();
+    std::future<bool> glyphsBaked = std::async(std::launch::async, [this, assetsOpened] {
+        assetsOpened.wait();
+        return bakeGlyphs();
+    });
+    std::future<bool> stateLoaded = std::async(std::launch::async, [this] { return loadInitialState(); });
+    std::future<void> leaderboardLoaded = std::async(std::launch::async, [this] { loadLeaderboard(); });
+    // przy wcześniejszym return destruktory przyszłości z std::async czekają na zadania, więc nie przeżyją silnika
+
+    Uint32 sdlFlags = options.headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO; // bez wideo nie potrzeba ekranu
+    if (SDL_Init(sdlFlags) < 0) {
+        std::cerr << "SDL could not initialize! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    inputSystem.install();
+
+    if (options.headless) {
+        renderer = std::make_unique<NullRenderer>();
+    }
+    else {
+        renderer = std::make_unique<SdlRenderer>();
+    }
+    if (!renderer->initialize("Space Invader", SCREEN_WIDTH, SCREEN_HEIGHT)) {
         return false;
     }
 
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    if (!renderer) {
-        std::cerr << "Renderer could not be created! SDL Error: " << SDL_GetError() << std::endl;
+    if (!(glyphsBaked.get() && textAtlas.upload(*renderer))) {
+        SDL_Log("Text will not be rendered");
+    }
+    leaderboardLoaded.get();
+    if (!stateLoaded.get()) {
         return false;
     }
-    if (!loadGameState("save.txt")) {
-        resetAliens();
+
+    Uint64 seed = options.seed;
+    if (replayReader.isOpen()) {
+        // odtwarzanie zaczyna od seeda zapisanego w nagraniu
+        seed = replayReader.getSeed();
+        options.tickRate = replayReader.getTickRate();
+        if (options.tickRate < EngineOptions::MIN_TICK_RATE || options.tickRate > EngineOptions::MAX_TICK_RATE) {
+            SDL_Log("Replay tick rate %d Hz is outside %d..%d", options.tickRate,
+                EngineOptions::MIN_TICK_RATE, EngineOptions::MAX_TICK_RATE);
+            return false;
+        }
+    }
+    if (seed == 0) {
+        seed = static_cast<Uint64>(std::time(nullptr)) ^ SDL_GetPerformanceCounter();
     }
+    sim.rng.seed(seed);
+    sim.tickRate = options.tickRate;
 
-    score = 0; 
-    loadHighScore("highscore.txt"); 
+    if (!options.recordPath.empty()) {
+        std::ostringstream initialState;
+        sim.writeState(initialState);
+        if (!replayWriter.open(options.recordPath, seed, options.tickRate, initialState.str())) {
+            return false;
+        }
+    }
 
+    if (!options.profileCsvPath.empty()) {
+        profiler.openCsv(options.profileCsvPath);
+    }
+
+    sim.score = 0; 
 
+    // przebieg headless (test, pomiar) nie rusza zapisu gracza
+    if (!replayReader.isOpen() && !options.headless) {
+        startJournal(); // odzyskany stan staje się nowym pełnym zapisem z pustym dziennikiem
+    }
+
+    initializedCounter = SDL_GetPerformanceCounter();
    // resetAliens();
     return true;
 }
-//rozpoczyna gre i zapisuje jej stan na koniec
-void GameEngine::run() {
-    welcomeScreen();
-    while (running) {
-        processInput();
+//archiwum zostaje zmapowane do końca gry; bez niego assety są czytane z luźnych plików
+bool GameEngine::openAssets() {
+    TRACE_ZONE("startup assets");
+    return assets.open(ASSET_PACK_FILE);
+}
 
-        if (showHelp) {
-            showHelpScreen(); 
-            SDL_Delay(16);      
-            continue;         
+bool GameEngine::bakeGlyphs() {
+    TRACE_ZONE("startup glyphs");
+    SDL_RWops* font = assets.isOpen() ? assets.openRW(FONT_ASSET) : nullptr;
+    if (assets.isOpen() && !font) {
+        SDL_Log("%s has no %s", ASSET_PACK_FILE, FONT_ASSET);
+    }
+    if (!font) {
+        font = SDL_RWFromFile(FONT_ASSET, "rb");
+    }
+    return textAtlas.bake(font, 24);
+}
+//stan początkowy z nagrania, zapisu tekstowego albo save.dat z dziennikiem; false tylko gdy nagranie nie daje się otworzyć
+bool GameEngine::loadInitialState() {
+    TRACE_ZONE("startup state");
+    if (!options.replayPath.empty()) {
+        // odtwarzanie zaczyna od stanu zapisanego w nagraniu, nie od zapisu gry
+        if (!replayReader.open(options.replayPath)) {
+            return false;
         }
-
-        if (!gameOver && !showHelp) {
-            update();
+        std::istringstream initialState(replayReader.getInitialState());
+        if (!sim.readState(initialState)) {
+            sim.resetAliens();
         }
-
-        if (gameOver) {
-            if (score > highScore) {
-                highScore = score;
-                saveHighScore("highscore.txt");
-            }
-            resetSaveFile("save.txt");
+    }
+    else if (!options.importSavePath.empty()) {
+        if (!importGameState(options.importSavePath)) {
+            sim.resetAliens();
         }
-
-        render();
-        SDL_Delay(16);
     }
+    else if (!loadGameState(SAVE_FILE)) {
+        sim.resetAliens();
+    }
+    return true;
 }
 
-//czyści assety
-void GameEngine::cleanup() {
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
-    TTF_Quit();
-    SDL_Quit();
+void GameEngine::loadLeaderboard() {
+    TRACE_ZONE("startup leaderboard");
+    leaderboard.open(LEADERBOARD_FILE, LEADERBOARD_INDEX_FILE);
+    loadHighScore("highscore.txt");
+}
+//główna pętla: zdarzenia, update i render bieżącej sceny
+//SDL_Renderer i zdarzenia okna wolno obsługiwać tylko na wątku, który je utworzył, więc przy FramePipeline
+//ten wątek tylko rysuje i zbiera zdarzenia, a pętla gry idzie na osobny wątek i publikuje gotowe kolejki
+void GameEngine::run() {
+    changeScene(options.headless ? SCENE_PLAYING : SCENE_WELCOME);
+    sim.storePreviousPositions();
+    resetClock();
+    if (!options.renderThread || options.headless) {
+        gameLoop();
+        return;
+    }
+    framePipeline.start(renderer.get(), COLOR_BLACK);
+    std::thread gameThread([this] {
+        Tracer::instance().setThreadName("game");
+        gameLoop();
+        framePipeline.close();
+    });
+    framePipeline.presentLoop([this] { inputSystem.pump(); });
+    gameThread.join();
+    firstFrameCounter = framePipeline.getFirstPresentCounter();
 }
-//zczytyje inputy z klawiatury i rozpatruje je jako eventy
-void GameEngine::processInput() {
-    SDL_Event event;
-    while (SDL_PollEvent(&event)) {
-        if (event.type == SDL_QUIT) {
-            running = false;
-        }
 
-        if (!gameOver && event.type == SDL_KEYDOWN) {
-            if (event.key.keysym.sym == SDLK_LEFT) {
-                player.moveLeft();
-            }
-            if (event.key.keysym.sym == SDLK_RIGHT) {
-                player.moveRight();
-            }
-            if (event.key.keysym.sym == SDLK_SPACE && !spacePressed) {
-                playerBullets.emplace_back(player.x + player.w / 2 - 5, player.y - 10, 5, 10);
-                spacePressed = true;
-            }
-            if (event.key.keysym.sym == SDLK_q) {
-                showHelp = !showHelp; 
-            }
-            if (event.key.keysym.sym == SDLK_ESCAPE) {
-                if (confirmExit()) {
-                    running = false;
-                }
-            }
+void GameEngine::gameLoop() {
+    bool pipelined = framePipeline.isRunning();
+    while (running) {
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        profiler.beginFrame();
+        {
+            PROFILE_SCOPE(profiler, PHASE_INPUT);
+            processInput();
+        }
+        {
+            PROFILE_SCOPE(profiler, PHASE_UPDATE);
+            updateScene();
+        }
+        renderScene();
+        profiler.endFrame();
+        if (firstFrameCounter == 0 && !pipelined) {
+            firstFrameCounter = SDL_GetPerformanceCounter();
         }
 
-        if (event.type == SDL_KEYUP) {
-            if (event.key.keysym.sym == SDLK_SPACE) {
-                spacePressed = false;
-            }
+        frameCount++;
+        if (options.maxFrames > 0 && frameCount >= options.maxFrames) {
+            running = false;
         }
+        waitForNextTick(frameStart);
     }
 }
-
-//sprawdza obecny stan przeciwników
-void GameEngine::analyzeAliens(int* activeCount, int* totalCount, int* speed) {
-    int active = 0;
-    int total = 0;
-
-    for (const auto& alien : aliens) {
-        if (alien.active) {
-            active++;
+//bez vsync (wyłączonego przez sterownik albo niedostępnego) pętla kręciłaby się na pusto w każdej scenie,
+//więc klatka krótsza od ticka dosypia resztę ticka; z vsync present sam czeka i tu nic się nie dzieje
+void GameEngine::waitForNextTick(Uint64 frameStart) {
+    if (options.headless) {
+        return;
+    }
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 tickLength = std::max<Uint64>(frequency / options.tickRate, 1); // zegar rzadszy niż ticki nie daje zera
+    Uint64 elapsed = SDL_GetPerformanceCounter() - frameStart;
+    if (elapsed < tickLength) {
+        Uint32 remainingMs = static_cast<Uint32>((tickLength - elapsed) * 1000 / frequency);
+        if (remainingMs > 0) {
+            SDL_Delay(remainingMs);
         }
-        total++;
     }
-
-    *activeCount = active;
-    *totalCount = total;
-
-    *speed = 1 + (level / 2);
 }
-//nadpisuje stan gry w każdej klatce (ruch przeciwników pocisków i gracza)
-//sprawdza kolizje,strzały obcych,progres poziomu i warunki game overu
-void GameEngine::update() {
-    int activeAliens = 0;
-    int totalAliens = 0;
-    int currentSpeed = 0;
-
-    analyzeAliens(&activeAliens, &totalAliens, &currentSpeed);
-    
-    alienSpeed = currentSpeed;
-
-    SDL_Log("Debug -> Active Aliens: %d, Total Aliens: %d, Alien Speed: %d", activeAliens, totalAliens, currentSpeed);
-
-    for (auto& bullet : playerBullets) {
-        bullet.move();
+//przełącza scenę i wywołuje wejście do nowej; skutki uboczne przejść dzieją się tylko tu
+void GameEngine::changeScene(Scene next) {
+    if (next == scene) {
+        return;
     }
-    playerBullets.erase(std::remove_if(playerBullets.begin(), playerBullets.end(),
-        [](const Bullet& b) { return !b.active; }),
-        playerBullets.end());
+    Scene previous = scene;
+    scene = next;
+    enterScene(next, previous);
+}
 
-    for (auto& bullet : alienBullets) {
-        bullet.y += 4;
-        if (bullet.y > SCREEN_HEIGHT) {
-            bullet.active = false;
+void GameEngine::enterScene(Scene entered, Scene previous) {
+    switch (entered) {
+    case SCENE_PLAYING:
+        resetClock(); // czas spędzony w innej scenie nie jest nadrabiany
+        inputSystem.clearActions(); // strzały wciśnięte poza grą nie trafiają do następnego ticka
+        break;
+    case SCENE_CONFIRM_EXIT:
+        sceneBeforeExitPrompt = previous;
+        break;
+    case SCENE_GAME_OVER:
+        if (options.headless) {
+            running = false; // bez okna nikt nie zamknie ekranu game over, a pętla nie czeka na zegar
+            break;           // przebieg headless nie zapisuje też wyników ani stanu gracza
         }
-    }
-    alienBullets.erase(std::remove_if(alienBullets.begin(), alienBullets.end(),
-        [](const Bullet& b) { return !b.active; }),
-        alienBullets.end());
-
-    bool changeDirection = false;
-    for (auto& alien : aliens) {
-        alien.move(alienDirection * alienSpeed);
-        if (alien.x <= 0 || alien.x + alien.w >= SCREEN_WIDTH) {
-            changeDirection = true;
+        if (replayReader.isOpen()) {
+            break;
         }
+        journaling = false;
+        recordFinishedGame();
+        resetSaveFile(SAVE_FILE);
+        break;
+    default:
+        break;
     }
+}
 
-    if (changeDirection) {
-        alienDirection *= -1;
-        for (auto& alien : aliens) {
-            alien.y += 10;
-            if (alien.active && alien.y + alien.h >= player.y && alien.x < player.x + player.w && alien.x + alien.w > player.x) {
-                gameOver = true;
-            }
-        }
+void GameEngine::updateScene() {
+    TRACE_ZONE("update");
+    if (scene == SCENE_PLAYING) {
+        updatePlaying();
     }
-
-    alienFire();
-
-    for (auto& bullet : playerBullets) {
-        for (auto& alien : aliens) {
-            if (bullet.active && alien.active &&
-                bullet.x < alien.x + alien.w && bullet.x + bullet.w > alien.x &&
-                bullet.y < alien.y + alien.h && bullet.y + bullet.h > alien.y) {
-                bullet.active = false;
-                alien.active = false;
-                score += 10;
-            }
+}
+//stały krok symulacji: zaległy czas jest zjadany tickami po tickLength, reszta idzie w interpolację
+void GameEngine::updatePlaying() {
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 tickLength = std::max<Uint64>(frequency / options.tickRate, 1); // zegar rzadszy niż ticki nie daje zera
+    Uint64 maxFrameLength = frequency / 4; // dłuższa klatka (np. zawieszone okno) nie jest nadrabiana
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 elapsed = now - lastCounter;
+    lastCounter = now;
+    if (elapsed > maxFrameLength) {
+        elapsed = maxFrameLength;
+    }
+    // bez ekranu symulacja nie czeka na zegar, każda iteracja to jeden tick
+    accumulator = options.headless ? tickLength : accumulator + elapsed;
+
+    Uint32 nowMs = SDL_GetTicks(); // zegar znaczników zdarzeń SDL
+    int ticks = 0;
+    while (accumulator >= tickLength && ticks < MAX_TICKS_PER_FRAME && !sim.gameOver) {
+        // tick kończy się tyle przed teraz, ile czasu zostaje w akumulatorze po nim
+        Uint32 tickEnd = nowMs - static_cast<Uint32>((accumulator - tickLength) * 1000 / frequency);
+        InputFrame input;
+        if (!nextInput(&input, tickEnd)) {
+            running = false;
+            break;
         }
+        sim.storePreviousPositions();
+        sim.update(input);
+        accumulator -= tickLength;
+        ticks++;
     }
+    if (accumulator >= tickLength) {
+        accumulator %= tickLength; // spirala śmierci: resztę zaległych ticków odrzucamy
+    }
+    alpha = static_cast<float>(accumulator) / tickLength;
 
-    for (auto& bullet : alienBullets) {
-        if (bullet.active && bullet.x < player.x + player.w && bullet.x + bullet.w > player.x &&
-            bullet.y < player.y + player.h && bullet.y + bullet.h > player.y) {
-            bullet.active = false;
-            playerHealth--;
-            if (playerHealth <= 0) {
-                gameOver = true;
-            }
+    if (journaling && sim.tickCount - lastAutosaveTick >= static_cast<Uint32>(options.tickRate)) {
+        autosave();
+    }
+    if (sim.gameOver) {
+        changeScene(SCENE_GAME_OVER);
+    }
+}
+//wejście dla następnego ticka: z klawiatury albo z nagrania, przy nagrywaniu trafia do pliku
+//zwraca false, gdy nagranie się skończyło
+bool GameEngine::nextInput(InputFrame* input, Uint32 tickEnd) {
+    if (replayReader.isOpen()) {
+        inputSystem.clearActions(); // przy odtwarzaniu wciśnięcia z klawiatury nie idą do symulacji
+        if (!replayReader.read(input)) {
+            SDL_Log("Replay finished after %u ticks", replayReader.getTick());
+            return false;
         }
+        return true;
     }
 
-    if (std::all_of(aliens.begin(), aliens.end(), [](const Alien& a) { return !a.active; })) {
-        level++;
-        alienSpeed++;
-        resetAliens();
+    *input = inputSystem.sampleTick(tickEnd);
+    if (replayWriter.isOpen()) {
+        replayWriter.write(*input);
     }
+    return true;
+}
+//zaczyna odliczanie czasu od nowa, np. po ekranie pomocy, żeby pauza nie była nadrabiana
+void GameEngine::resetClock() {
+    lastCounter = SDL_GetPerformanceCounter();
+    accumulator = 0;
 }
-//renderuje obiekty na ekranie tło postać obcych pociski zdrowie poziom help game over welcome
-void GameEngine::render() {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
 
-    if (gameOver) {
-        SDL_Color red = { 255, 0, 0, 255 };
-        renderText("Game Over!", red, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50);
-        renderText("Your Score: " + std::to_string(score), red, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2);
-        renderText("High Score: " + std::to_string(highScore), red, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 50);
+//czyści assety
+void GameEngine::cleanup() {
+    if (replayWriter.isOpen() || replayReader.isOpen()) {
+        SDL_Log("Final state after %u ticks: score %d, level %d, checksum %08x",
+            sim.tickCount, sim.score, sim.level, sim.checksum());
     }
-    else if (showHelp) {
-        showHelpScreen();
+    replayWriter.close();
+    if (firstFrameCounter != 0) {
+        double msPerTick = 1000.0 / SDL_GetPerformanceFrequency();
+        SDL_Log("Startup: first frame presented %.1f ms after process start (initialize %.1f ms)",
+            (firstFrameCounter - processStart) * msPerTick, (initializedCounter - initializeStart) * msPerTick);
     }
-    else {
-        player.render(renderer);
-
-        for (auto& alien : aliens) {
-            alien.render(renderer);
-        }
 
-        for (auto& bullet : playerBullets) {
-            bullet.render(renderer);
-        }
+    if (Tracer::instance().isRecording()) {
+        toggleTrace();
+    }
 
-        for (auto& bullet : alienBullets) {
-            bullet.render(renderer);
+    // zapisy zgłoszone przed wyjściem muszą trafić na dysk, zanim proces się skończy
+    saveWorker.shutdown();
+    if (pendingSave.valid()) {
+        if (pendingSave.get()) {
+            SDL_Log("Game state saved to %s", SAVE_FILE);
         }
-
-        for (int i = 0; i < playerHealth; ++i) {
-            SDL_Rect healthBar = { 10, 50 + (i * 20), 10, 10 };
-            SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-            SDL_RenderFillRect(renderer, &healthBar);
+        else {
+            SDL_Log("Failed to save game state to %s", SAVE_FILE);
         }
-
-        SDL_Color white = { 255, 255, 255, 255 };
-        renderText("Level: " + std::to_string(level), white, 10, 10);
     }
 
-    SDL_RenderPresent(renderer);
-}
+    if (renderer) {
+        textAtlas.release(*renderer);
+        renderer->shutdown();
 
-//resetuje obych na potrzebe nowego poziomu i zmienia ich status na aktywny
-void GameEngine::resetAliens() {
-    aliens.clear();
-    int rows = (level <= 2) ? 3 : (level <= 4) ? 5 : 6;
-    int speedIncrement = (level <= 2) ? 0 : (level <= 4) ? 1 : 2;
-
-    alienSpeed = 1 + speedIncrement;
-
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < 5; ++j) {
-            aliens.emplace_back(j * 100 + 50, i * 50 + 50, 40, 20);
+        const RenderStats& stats = renderer->getStats();
+        if (options.headless) {
+            SDL_Log("Headless run: %lld frames, %lld draw calls, %lld rects, %lld vertices",
+                stats.frames, stats.drawCalls, stats.rects, stats.vertices);
         }
+        renderer.reset();
     }
+    TTF_Quit();
+    SDL_Quit();
 }
-//losuje który obcy strzeli
-void GameEngine::alienFire() {
-    if (std::rand() % 100 < 5) {
-        int shooterIndex = std::rand() % aliens.size();
-        if (aliens[shooterIndex].active) {
-            alienBullets.emplace_back(aliens[shooterIndex].x + aliens[shooterIndex].w / 2 - 2, aliens[shooterIndex].y + aliens[shooterIndex].h, 5, 10);
+//zczytyje inputy z klawiatury i przekazuje je bieżącej scenie
+void GameEngine::processInput() {
+    TRACE_ZONE("input");
+    if (!framePipeline.isRunning()) {
+        inputSystem.pump(); // przy FramePipeline zdarzenia zbiera wątek rysujący
+    }
+    if (inputSystem.quitRequested()) {
+        running = false;
+    }
+    KeyPress press;
+    while (inputSystem.nextKeyPress(&press)) {
+        if (press.key == SDLK_F3) {
+            showProfiler = !showProfiler; // działa w każdej scenie
+        }
+        else if (press.key == SDLK_F4) {
+            toggleTrace();
+        }
+        else {
+            handleKey(press.key);
         }
     }
 }
-//welcome screen
-void GameEngine::welcomeScreen() {
-    bool inWelcomeScreen = true;
 
-    SDL_Color white = { 255, 255, 255, 255 };
-    while (inWelcomeScreen) {
-        SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                running = false;
-                inWelcomeScreen = false;
-            }
-            else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_RETURN) {
-                inWelcomeScreen = false;
-            }
+void GameEngine::handleKey(SDL_Keycode key) {
+    switch (scene) {
+    case SCENE_WELCOME:
+        if (key == SDLK_RETURN) {
+            changeScene(SCENE_PLAYING);
         }
-
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-
-        renderText("Press Enter to Start", white, SCREEN_WIDTH / 2 - 150, SCREEN_HEIGHT / 2 - 50);
-        SDL_RenderPresent(renderer);
+        break;
+    case SCENE_PLAYING:
+        // ruch i strzał czyta nextInput raz na tick
+        if (key == SDLK_q) {
+            changeScene(SCENE_HELP);
+        }
+        if (key == SDLK_ESCAPE) {
+            changeScene(SCENE_CONFIRM_EXIT);
+        }
+        break;
+    case SCENE_HELP:
+        if (key == SDLK_q) {
+            changeScene(SCENE_PLAYING);
+        }
+        if (key == SDLK_ESCAPE) {
+            changeScene(SCENE_CONFIRM_EXIT);
+        }
+        break;
+    case SCENE_CONFIRM_EXIT:
+        if (key == SDLK_y) {
+            saveGameState(SAVE_FILE); // zapis przed wyjsciem z gry
+            running = false;
+        }
+        if (key == SDLK_n) {
+            changeScene(sceneBeforeExitPrompt);
+        }
+        break;
+    default:
+        break;
     }
 }
-//wyświetla help
-void GameEngine::showHelpScreen() {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
-
-    SDL_Color white = { 255, 255, 255, 255 };
-    renderText("Help Screen", white, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 150);
-    renderText("Arrow Keys: Move", white, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 100);
-    renderText("Space: Shoot", white, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 70);
-    renderText("Press F1/Esc (my f1 key doesnt work) to Resume", white, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 40);
 
-    SDL_RenderPresent(renderer);
-}
+//renderuje tło i to, co bieżąca scena dopisze do kolejki
+//z FramePipeline scena trafia do jego kolejki, a flush i present robi wątek główny w czasie następnego ticka
+void GameEngine::renderScene() {
+    TRACE_ZONE("render");
+    {
+        PROFILE_SCOPE(profiler, PHASE_TEXT);
+        updateHudText();
+    }
+
+    bool pipelined = framePipeline.isRunning();
+    RenderQueue& queue = pipelined ? framePipeline.getWriteQueue() : renderQueue;
+    {
+        PROFILE_SCOPE(profiler, PHASE_RENDER);
+        if (!pipelined) {
+            renderer->clear(COLOR_BLACK);
+        }
+        switch (scene) {
+        case SCENE_WELCOME:
+            welcomeText.display(queue, SCREEN_WIDTH / 2 - 150, SCREEN_HEIGHT / 2 - 50);
+            break;
+        case SCENE_PLAYING:
+            renderPlaying(queue, alpha);
+            break;
+        case SCENE_HELP:
+            renderHelp(queue);
+            break;
+        case SCENE_CONFIRM_EXIT:
+            // pytanie leży na zamrożonej klatce sceny, z której przyszło
+            if (sceneBeforeExitPrompt == SCENE_HELP) {
+                renderHelp(queue);
+            }
+            else {
+                renderPlaying(queue, 1.0f);
+            }
+            exitPromptText.display(queue, SCREEN_WIDTH / 2 - 200, SCREEN_HEIGHT / 2);
+            break;
+        case SCENE_GAME_OVER:
+            gameOverText.display(queue, SCREEN_WIDTH / 2 - 100, 40);
+            scoreText.display(queue, SCREEN_WIDTH / 2 - 100, 90);
+            highScoreText.display(queue, SCREEN_WIDTH / 2 - 100, 125);
+            rankText.display(queue, SCREEN_WIDTH / 2 - 100, 160);
+            topTitleText.display(queue, SCREEN_WIDTH / 2 - 100, 215);
+            for (size_t i = 0; i < leaderboard.getTop().size(); ++i) {
+                topTexts[i].display(queue, SCREEN_WIDTH / 2 - 150, 250 + static_cast<int>(i) * 30);
+            }
+            break;
+        default:
+            break;
+        }
 
-//wyświetla text używa predefiniowanej trzczionki i rederera do wyświetlania tekstu
-void GameEngine::renderText(const std::string& message, const SDL_Color& color, int x, int y) {
-    TTF_Font* font = TTF_OpenFont("res/arial.ttf", 24);
-    if (!font) {
-        SDL_Log("Failed to load font: %s", TTF_GetError());
-        return;
+        if (showProfiler) {
+            renderProfilerOverlay(queue);
+        }
     }
 
-    SDL_Surface* surface = TTF_RenderText_Solid(font, message.c_str(), color);
-    if (!surface) {
-        TTF_CloseFont(font);
-        SDL_Log("Failed to create surface: %s", TTF_GetError());
+    if (pipelined) {
+        {
+            TRACE_ZONE("publish");
+            framePipeline.publish();
+        }
+        // flush i present ostatniej narysowanej klatki, żeby nakładka i CSV miały ten sam podział faz;
+        // liczą się równolegle z tą klatką, więc nie sumują się do jej czasu
+        profiler.add(PHASE_FLUSH, framePipeline.getLastFlushTicks());
+        profiler.add(PHASE_PRESENT, framePipeline.getLastPresentTicks());
         return;
     }
-
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    TTF_CloseFont(font);
-
-    if (texture) {
-        SDL_Rect textRect = { x, y, 300, 50 };
-        SDL_RenderCopy(renderer, texture, nullptr, &textRect);
-        SDL_DestroyTexture(texture);
+    {
+        PROFILE_SCOPE(profiler, PHASE_FLUSH);
+        TRACE_ZONE("flush");
+        renderQueue.flush(*renderer);
     }
-    else {
-        SDL_Log("Failed to create texture: %s", SDL_GetError());
+    {
+        PROFILE_SCOPE(profiler, PHASE_PRESENT);
+        TRACE_ZONE("present");
+        renderer->present();
     }
 }
-//wczytuje dane z pliku savefile
-void GameEngine::saveGameState(const std::string& filename) {
-    std::ofstream saveFile(filename);
-    if (!saveFile) {
-        SDL_Log("Failed to open save file: %s", filename.c_str());
-        return;
+//świat gry interpolowany między dwoma ostatnimi tickami i numer poziomu
+void GameEngine::renderPlaying(RenderQueue& queue, float frameAlpha) {
+    sim.render(queue, frameAlpha);
+    levelText.display(queue, 10, 10);
+}
+//formatuje liczby na ekranie tylko wtedy, gdy ich wartość się zmieniła
+void GameEngine::updateHudText() {
+    if (shownLevel != sim.level) {
+        shownLevel = sim.level;
+        levelText.setText("Level: " + std::to_string(sim.level));
     }
-
-    saveFile << "Player " << player.x << " " << player.y << " " << playerHealth << "\n";
-
-    saveFile << "Level " << level << "\n";
-    saveFile << "AlienSpeed " << alienSpeed << "\n";
-    saveFile << "AlienDirection " << alienDirection << "\n";
-
-    saveFile << "Aliens " << aliens.size() << "\n";
-    for (const auto& alien : aliens) {
-        saveFile << alien.x << " " << alien.y << " " << alien.active << "\n";
+    if (shownScore != sim.score) {
+        shownScore = sim.score;
+        scoreText.setText("Your Score: " + std::to_string(sim.score));
     }
+    if (shownHighScore != highScore) {
+        shownHighScore = highScore;
+        highScoreText.setText("High Score: " + std::to_string(highScore));
+    }
+}
 
-    saveFile.close();
-    SDL_Log("Game state saved to %s", filename.c_str());
+//wyświetla help
+void GameEngine::renderHelp(RenderQueue& queue) {
+    helpTitleText.display(queue, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 150);
+    helpMoveText.display(queue, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 100);
+    helpShootText.display(queue, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 70);
+    helpResumeText.display(queue, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 40);
 }
 
-bool GameEngine::confirmExit() {
-    SDL_Color white = { 255, 255, 255, 255 };
-    renderText("Exit? Press Y to save and exit, N to cancel", white, SCREEN_WIDTH / 2 - 200, SCREEN_HEIGHT / 2);
-    SDL_RenderPresent(renderer);
+//włącza nagrywanie śladu albo je zatrzymuje i oddaje do zapisu ostatnie TRACE_WINDOW_SECONDS sekund
+void GameEngine::toggleTrace() {
+    Tracer& tracer = Tracer::instance();
+    if (!tracer.isRecording()) {
+        tracer.setRecording(true);
+        SDL_Log("Trace recording started");
+        return;
+    }
+    tracer.setRecording(false);
+    std::string json = tracer.exportJson(TRACE_WINDOW_SECONDS);
+    std::string path = options.tracePath.empty() ? DEFAULT_TRACE_FILE : options.tracePath;
+    saveWorker.submit(path, std::vector<Uint8>(json.begin(), json.end()));
+    SDL_Log("Trace of the last %.0f s saved to %s", TRACE_WINDOW_SECONDS, path.c_str());
+}
 
-    SDL_Event event;
-    while (true) {
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_KEYDOWN) {
-                if (event.key.keysym.sym == SDLK_y) {
-                    saveGameState("save.txt"); // zapis przed wyjsciem z gry
-                    return true;
-                }
-                if (event.key.keysym.sym == SDLK_n) {
-                    return false;
-                }
-            }
+//wykres czasów ostatnich klatek (linia = 16.7 ms) i p50 / p99 każdej fazy z okna profilera
+void GameEngine::renderProfilerOverlay(RenderQueue& queue) {
+    const int panelX = SCREEN_WIDTH - 380;
+    const int panelY = 10;
+    const int graphHeight = 80;
+    const float pixelsPerMs = 3.0f;
+    SDL_Rect panel = { panelX, panelY, 370, graphHeight + 20 + PHASE_COUNT * 26 };
+    queue.fillRect(panel, SDL_Color{ 20, 20, 20, 255 }, RenderQueue::LAYER_PANEL);
+
+    int graphBottom = panelY + 10 + graphHeight;
+    for (int age = 0; age < profiler.getFrameCount(); ++age) {
+        float ms = profiler.getFrameMs(age);
+        int height = std::min(graphHeight, std::max(1, static_cast<int>(ms * pixelsPerMs)));
+        SDL_Color color = ms <= 16.7f ? SDL_Color{ 0, 200, 0, 255 } :
+            ms <= 33.4f ? SDL_Color{ 230, 200, 0, 255 } : SDL_Color{ 230, 0, 0, 255 };
+        SDL_Rect bar = { panelX + 365 - (age + 1) * 3 / 2, graphBottom - height, 1, height };
+        queue.fillRect(bar, color, RenderQueue::LAYER_HUD);
+    }
+    SDL_Rect budgetLine = { panelX + 5, graphBottom - static_cast<int>(16.7f * pixelsPerMs), 360, 1 };
+    queue.fillRect(budgetLine, COLOR_WHITE, RenderQueue::LAYER_HUD);
+
+    // napisy przeliczane co kilka klatek, żeby się dało je przeczytać i żeby nie przebudowywać geometrii co klatkę
+    if (frameCount % 15 == 0) {
+        for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+            PhaseStats stats = profiler.getStats(static_cast<ProfilePhase>(phase));
+            char line[64];
+            std::snprintf(line, sizeof(line), "%-8s %5.1f / %5.1f ms",
+                Profiler::getPhaseName(static_cast<ProfilePhase>(phase)), stats.p50Ms, stats.p99Ms);
+            profilerTexts[phase].setText(line);
         }
     }
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        profilerTexts[phase].display(queue, panelX + 8, graphBottom + 8 + phase * 26);
+    }
 }
 
-bool GameEngine::loadGameState(const std::string& filename) {
-    std::ifstream loadFile(filename);
-    if (!loadFile) {
-        SDL_Log("Failed to open save file: %s", filename.c_str());
-        return false;
+//robi w pamięci kopię stanu gry i oddaje ją do zapisu w tle, pętla gry nie czeka na dysk
+void GameEngine::saveGameState(const std::string& filename) {
+    submitSnapshot(filename, sim);
+    journal.begin(sim);
+    journalBytes = 0;
+    if (!options.exportSavePath.empty()) {
+        exportGameState(options.exportSavePath);
     }
+}
 
-    std::string line, label;
-    int alienCount;
-
-    loadFile >> label >> player.x >> player.y >> playerHealth;
-
-    loadFile >> label >> level;
-    loadFile >> label >> alienSpeed;
-    loadFile >> label >> alienDirection;
-
-    loadFile >> label >> alienCount;
-    aliens.clear();
-    for (int i = 0; i < alienCount; ++i) {
-        int x, y, active;
-        loadFile >> x >> y >> active;
-        aliens.emplace_back(x, y, 40, 20);
-        aliens.back().active = active;
+//pełny zapis razem z dziennikiem autozapisu, więc po awarii gra wraca do stanu sprzed ostatniego autozapisu
+bool GameEngine::loadGameState(const std::string& filename) {
+    if (!AutosaveJournal::load(filename, JOURNAL_FILE, &sim)) {
+        return false;
     }
-
-    loadFile.close();
     SDL_Log("Game state loaded from %s", filename.c_str());
     return true;
 }
-//wczytuje highscore z pliki , w przypadku niepowoedzenia ustawia go na 0
-void GameEngine::loadHighScore(const std::string& filename) {
-    std::ifstream file(filename);
-    if (file.is_open()) {
-        file >> highScore;
-        file.close();
+//zapis tekstowy: ten sam format co nagłówek nagrania, do podglądu i ręcznej edycji
+void GameEngine::exportGameState(const std::string& filename) {
+    std::ostringstream text;
+    sim.writeState(text);
+    std::string state = text.str();
+    saveWorker.submit(filename, std::vector<Uint8>(state.begin(), state.end()));
+}
+//wczytuje zapis tekstowy do osobnej symulacji, więc niepełny plik nie psuje bieżącego stanu
+bool GameEngine::importGameState(const std::string& filename) {
+    std::ifstream importFile(filename);
+    if (!importFile) {
+        SDL_Log("Failed to open import file: %s", filename.c_str());
+        return false;
     }
-    else {
-        highScore = 0;
+    Simulation imported;
+    if (!imported.readState(importFile)) {
+        SDL_Log("Rejected text save: %s", filename.c_str());
+        return false;
     }
+    sim = imported;
+    SDL_Log("Game state imported from %s", filename.c_str());
+    return true;
 }
-//zapisuje obecny high score do pliku
-void GameEngine::saveHighScore(const std::string& filename) {
-    std::ofstream file(filename);
-    if (file.is_open()) {
-        file << highScore;
-        file.close();
+
+//highscore.txt z wersji sprzed tablicy wyników trafia do pustej tablicy jako wynik bez daty
+void GameEngine::loadHighScore(const std::string& filename) {
+    std::ifstream file(filename);
+    int legacyScore = 0;
+    // przeniesienie starego rekordu to zapis, którego przebieg headless nie robi
+    if (!options.headless && leaderboard.getCount() == 0 && file >> legacyScore && legacyScore > 0) {
+        LeaderboardEntry entry = { 0, legacyScore, 0, 0 };
+        std::vector<Uint8> entryBytes;
+        std::vector<Uint8> indexBytes;
+        leaderboard.add(entry, &entryBytes, &indexBytes);
+        saveWorker.append(LEADERBOARD_FILE, std::move(entryBytes));
+        saveWorker.submit(LEADERBOARD_INDEX_FILE, std::move(indexBytes));
+    }
+    highScore = leaderboard.getBestScore();
+}
+//dopisuje zakończoną grę do tablicy wyników i przygotowuje napisy ekranu game over
+void GameEngine::recordFinishedGame() {
+    LeaderboardEntry entry;
+    entry.timestamp = static_cast<Sint64>(std::time(nullptr));
+    entry.score = sim.score;
+    entry.level = sim.level;
+    entry.durationMs = static_cast<Uint32>(static_cast<Uint64>(sim.tickCount) * 1000 / options.tickRate);
+
+    std::vector<Uint8> entryBytes;
+    std::vector<Uint8> indexBytes;
+    int rank = leaderboard.add(entry, &entryBytes, &indexBytes);
+    saveWorker.append(LEADERBOARD_FILE, std::move(entryBytes));
+    saveWorker.submit(LEADERBOARD_INDEX_FILE, std::move(indexBytes));
+    highScore = leaderboard.getBestScore();
+
+    rankText.setText("Rank: " + std::to_string(rank) + " of " + std::to_string(leaderboard.getCount()));
+    const std::vector<LeaderboardEntry>& top = leaderboard.getTop();
+    for (size_t i = 0; i < top.size(); ++i) {
+        char date[16] = "-";
+        std::time_t when = static_cast<std::time_t>(top[i].timestamp);
+        std::tm local;
+#ifdef _WIN32
+        bool converted = localtime_s(&local, &when) == 0; // localtime jest pod /sdl błędem i dzieli bufor między wątki
+#else
+        bool converted = localtime_r(&when, &local) != nullptr;
+#endif
+        if (when != 0 && converted) {
+            std::strftime(date, sizeof(date), "%Y-%m-%d", &local);
+        }
+        Uint32 seconds = top[i].durationMs / 1000;
+        char line[96];
+        std::snprintf(line, sizeof(line), "%2d. %7d   level %-3d %3u:%02u   %s", static_cast<int>(i) + 1,
+            top[i].score, top[i].level, seconds / 60, seconds % 60, date);
+        topTexts[i].setText(line);
     }
 }
-//nadpisuje dane do wczytania stanu gry
+//nadpisuje zapis stanem nowej gry od pierwszego poziomu
 void GameEngine::resetSaveFile(const std::string& filename) {
-    std::ofstream saveFile(filename, std::ios::trunc); // nadpisuje plik zapisu
-    if (!saveFile) {
-        SDL_Log("Failed to reset save file: %s", filename.c_str());
+    Simulation initial;
+    initial.resetAliens();
+    submitSnapshot(filename, initial);
+}
+//pełny zapis i nagłówek nowego, pustego dziennika z CRC tego zapisu; stary dziennik przestaje pasować
+void GameEngine::submitSnapshot(const std::string& filename, const Simulation& state) {
+    TRACE_ZONE("encode save");
+    std::vector<Uint8> bytes;
+    encodeSave(state, &bytes);
+    Uint32 snapshotCrc = crc32(bytes.data(), bytes.size());
+    pendingSave = saveWorker.submit(filename, std::move(bytes));
+    saveWorker.submit(JOURNAL_FILE, AutosaveJournal::header(snapshotCrc));
+}
+
+void GameEngine::startJournal() {
+    submitSnapshot(SAVE_FILE, sim);
+    journal.begin(sim);
+    journalBytes = 0;
+    lastAutosaveTick = sim.tickCount;
+    journaling = true;
+}
+//co sekundę gry dopisuje do dziennika zmiany od poprzedniego wpisu; urośnięty dziennik scala wątek zapisu
+void GameEngine::autosave() {
+    lastAutosaveTick = sim.tickCount;
+    std::vector<Uint8> entry;
+    if (!journal.record(sim, &entry)) {
         return;
     }
-
-    
-    saveFile << "Player " << SCREEN_WIDTH / 2 - 25 << " " << SCREEN_HEIGHT - 60 << " 3\n";
-    saveFile << "Level 1\n";
-    saveFile << "AlienSpeed 1\n";
-    saveFile << "AlienDirection 1\n";
-
-    int initialRows = 3;
-    int aliensPerRow = 5;
-
-    saveFile << "Aliens " << (initialRows * aliensPerRow) << "\n";
-    for (int i = 0; i < initialRows; ++i) {
-        for (int j = 0; j < aliensPerRow; ++j) {
-            saveFile << j * 100 + 50 << " " << i * 50 + 50 << " 1\n"; // aktywuje alienów
-        }
+    journalBytes += entry.size();
+    saveWorker.append(JOURNAL_FILE, std::move(entry));
+    if (journalBytes >= JOURNAL_COMPACT_BYTES) {
+        saveWorker.run([] { return AutosaveJournal::compact(SAVE_FILE, JOURNAL_FILE); });
+        journalBytes = 0;
     }
-
-    saveFile.close();
-    SDL_Log("Save file reset to initial state: %s", filename.c_str());
 }
-
-
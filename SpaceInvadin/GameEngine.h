@@ -1,11 +1,24 @@
 #ifndef GAME_ENGINE_H
 #define GAME_ENGINE_H
 
-#include "Player.h"
-#include "Alien.h"
-#include "Bullet.h"
+#include "Simulation.h"
+#include "AssetPack.h"
+#include "GlyphAtlas.h"
+#include "Text.h"
+#include "RenderQueue.h"
+#include "FramePipeline.h"
+#include "Renderer.h"
+#include "EngineOptions.h"
+#include "InputFrame.h"
+#include "InputSystem.h"
+#include "Replay.h"
+#include "SaveWorker.h"
+#include "AutosaveJournal.h"
+#include "Leaderboard.h"
+#include "Profiler.h"
+#include "Trace.h"
 #include <vector>
-#include <cstdlib>
+#include <memory>
 #include <ctime>
 #include <string>
 #include "SDL.h"
@@ -13,56 +26,116 @@
 
 class GameEngine {
 public:
-    GameEngine();
+    //processStart to licznik SDL_GetPerformanceCounter z początku procesu, od niego liczony jest czas do pierwszej klatki;
+    //0 = od utworzenia silnika
+    explicit GameEngine(const EngineOptions& options = EngineOptions(), Uint64 processStart = 0);
     ~GameEngine();
 
     bool initialize();
-    void run();
+    void run(); // na wątku, który wołał initialize (utworzył okno i renderer)
     void cleanup();
 
 private:
+    //ekrany gry; każdy ma własną obsługę klawiszy, update i render, a przejścia idą przez changeScene
+    enum Scene {
+        SCENE_NONE,
+        SCENE_WELCOME,
+        SCENE_PLAYING,
+        SCENE_HELP,
+        SCENE_CONFIRM_EXIT,
+        SCENE_GAME_OVER
+    };
+
+    void changeScene(Scene next);
+    void enterScene(Scene entered, Scene previous);
+    void updateScene();
+    void renderScene();
+    void gameLoop();
+    void waitForNextTick(Uint64 frameStart);
+
     void processInput();
-    void update();
-    void render();
-    void resetAliens();
-    void alienFire();
-    void welcomeScreen();
-    void renderText(const std::string& message, const SDL_Color& color, int x, int y);
-    void showHelpScreen();
-    bool confirmExit();
+    void handleKey(SDL_Keycode key);
+    bool nextInput(InputFrame* input, Uint32 tickEnd);
+    void updatePlaying();
+    void renderPlaying(RenderQueue& queue, float frameAlpha);
+    void renderHelp(RenderQueue& queue);
+    void renderProfilerOverlay(RenderQueue& queue);
+    void toggleTrace();
+    void resetClock();
+    void updateHudText();
 
     void saveGameState(const std::string& filename);
     bool loadGameState(const std::string& filename);
+    void exportGameState(const std::string& filename);
+    bool importGameState(const std::string& filename);
 
+    bool openAssets();
+    bool bakeGlyphs();
+    bool loadInitialState();
+    void loadLeaderboard();
     void loadHighScore(const std::string& filename);
-    void saveHighScore(const std::string& filename);
+    void recordFinishedGame();
 
     void resetSaveFile(const std::string& filename);
+    void submitSnapshot(const std::string& filename, const Simulation& state);
+    void startJournal();
+    void autosave();
 
-    void analyzeAliens(int* activeCount, int* totalCount, int* speed);
-
-    SDL_Window* window;
-    SDL_Renderer* renderer;
+    EngineOptions options;
+    std::unique_ptr<Renderer> renderer;
+    RenderQueue renderQueue; // kolejka klatki, gdy rysowanie idzie w pętli gry
+    FramePipeline framePipeline;
+    AssetPack assets;
+    GlyphAtlas textAtlas;
+    Text welcomeText;
+    Text helpTitleText;
+    Text helpMoveText;
+    Text helpShootText;
+    Text helpResumeText;
+    Text exitPromptText;
+    Text gameOverText;
+    Text scoreText;
+    Text highScoreText;
+    Text levelText;
+    Text rankText;
+    Text topTitleText;
+    std::vector<Text> topTexts;
+    std::vector<Text> profilerTexts; // wiersz na fazę
+    int shownLevel;
+    int shownScore;
+    int shownHighScore;
     bool running;
-    bool gameOver;
-    bool spacePressed;
-    bool showHelp;
-    bool exitRequested;
+    Scene scene;
+    Scene sceneBeforeExitPrompt;
+    int frameCount;
+    Uint64 lastCounter;
+    Uint64 accumulator;
+    float alpha; // ułamek ticka do interpolacji w bieżącej klatce
+    Profiler profiler;
+    bool showProfiler;
+    InputSystem inputSystem;
+    ReplayWriter replayWriter;
+    ReplayReader replayReader;
+    SaveWorker saveWorker;
+    SaveHandle pendingSave;
+    AutosaveJournal journal;
+    bool journaling;
+    Uint32 lastAutosaveTick;
+    size_t journalBytes; // dopisane od ostatniego pełnego zapisu
 
-    Player player;
-    std::vector<Alien> aliens;
-    std::vector<Bullet> playerBullets;
-    std::vector<Bullet> alienBullets;
-
-    int playerHealth;
-    int level;
-    int alienSpeed;
-    int alienDirection;
-    int score;      
+    Simulation sim;
+    Leaderboard leaderboard;
     int highScore;
 
+    Uint64 processStart;
+    Uint64 initializeStart;
+    Uint64 initializedCounter;
+    Uint64 firstFrameCounter; // po pierwszym present, 0 = jeszcze nie było
+
     static constexpr int SCREEN_WIDTH = 800;
     static constexpr int SCREEN_HEIGHT = 600;
+    static constexpr int MAX_TICKS_PER_FRAME = 8;
+    static constexpr size_t JOURNAL_COMPACT_BYTES = 4096; // po tylu bajtach dziennik jest scalany z zapisem
 };
 
 #endif
@@ -0,0 +1,168 @@
+#include "GlyphAtlas.h"
+#include <algorithm>
+
+GlyphAtlas::GlyphAtlas()
+    : texture(0), baked(nullptr), atlasHeight(0), lineHeight(0) {
+    for (auto& glyph : glyphs) {
+        glyph.src = { 0, 0, 0, 0 };
+        glyph.advance = 0;
+    }
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    SDL_FreeSurface(baked);
+}
+
+//otwiera czcionkę jeden raz, renderuje wszystkie znaki i składa je w jedną powierzchnię; nie dotyka renderera
+bool GlyphAtlas::bake(SDL_RWops* fontData, int fontSize) {
+    SDL_FreeSurface(baked);
+    baked = nullptr;
+
+    TTF_Font* font = TTF_OpenFontRW(fontData, 1, fontSize);
+    if (!font) {
+        SDL_Log("Failed to load font: %s", TTF_GetError());
+        return false;
+    }
+    lineHeight = TTF_FontHeight(font);
+
+    SDL_Color white = { 255, 255, 255, 255 };
+    SDL_Surface* rendered[LAST_CHAR - FIRST_CHAR + 1] = {};
+
+    // pakowanie półkowe: znaki idą w rzędach o stałej szerokości atlasu
+    int penX = 0;
+    int penY = 0;
+    int rowHeight = 0;
+    for (int c = FIRST_CHAR; c <= LAST_CHAR; ++c) {
+        Glyph& glyph = glyphs[c - FIRST_CHAR];
+        glyph.src = { 0, 0, 0, 0 };
+        glyph.advance = 0;
+
+        int minX, maxX, minY, maxY, advance;
+        if (TTF_GlyphMetrics(font, static_cast<Uint16>(c), &minX, &maxX, &minY, &maxY, &advance) == 0) {
+            glyph.advance = advance;
+        }
+
+        SDL_Surface* surface = TTF_RenderGlyph_Blended(font, static_cast<Uint16>(c), white);
+        rendered[c - FIRST_CHAR] = surface;
+        if (!surface) {
+            continue; // np. spacja nie ma pikseli, wystarczy jej advance
+        }
+
+        if (penX + surface->w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+        glyph.src = { penX, penY, surface->w, surface->h };
+        penX += surface->w + 1;
+        rowHeight = std::max(rowHeight, surface->h);
+    }
+    TTF_CloseFont(font);
+
+    atlasHeight = penY + rowHeight;
+    baked = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, std::max(atlasHeight, 1), 32, SDL_PIXELFORMAT_RGBA32);
+    if (baked) {
+        for (int i = 0; i <= LAST_CHAR - FIRST_CHAR; ++i) {
+            if (rendered[i]) {
+                SDL_Rect dst = glyphs[i].src;
+                SDL_SetSurfaceBlendMode(rendered[i], SDL_BLENDMODE_NONE);
+                SDL_BlitSurface(rendered[i], nullptr, baked, &dst);
+            }
+        }
+    }
+    for (auto* surface : rendered) {
+        SDL_FreeSurface(surface);
+    }
+
+    if (!baked) {
+        SDL_Log("Failed to create glyph atlas surface: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+//przenosi wypieczoną powierzchnię do tekstury i ją zwalnia
+bool GlyphAtlas::upload(Renderer& renderer) {
+    release(renderer);
+    if (!baked) {
+        return false;
+    }
+    texture = renderer.createTexture(baked);
+    SDL_FreeSurface(baked);
+    baked = nullptr;
+
+    if (!texture) {
+        SDL_Log("Failed to create glyph atlas texture: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+void GlyphAtlas::release(Renderer& renderer) {
+    if (texture) {
+        renderer.destroyTexture(texture);
+        texture = 0;
+    }
+}
+
+bool GlyphAtlas::isLoaded() const {
+    return texture != 0;
+}
+
+TextureId GlyphAtlas::getTexture() const {
+    return texture;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::findGlyph(char c) const {
+    int index = static_cast<unsigned char>(c) - FIRST_CHAR;
+    if (index < 0 || index > LAST_CHAR - FIRST_CHAR) {
+        index = '?' - FIRST_CHAR;
+    }
+    return &glyphs[index];
+}
+//liczy rozmiar napisu z metryk znaków bez rysowania
+void GlyphAtlas::measure(const std::string& message, int* width, int* height) const {
+    int total = 0;
+    for (char c : message) {
+        total += findGlyph(c)->advance;
+    }
+    *width = total;
+    *height = lineHeight;
+}
+//dopisuje po jednym czworokącie na znak do podanych buforów
+void GlyphAtlas::layout(const std::string& message, const SDL_Color& color, int x, int y,
+    std::vector<SDL_Vertex>& vertices, std::vector<int>& indices) const {
+    if (!texture) {
+        return;
+    }
+
+    float invWidth = 1.0f / ATLAS_WIDTH;
+    float invHeight = 1.0f / std::max(atlasHeight, 1);
+    int penX = x;
+    for (char c : message) {
+        const Glyph* glyph = findGlyph(c);
+        if (glyph->src.w > 0) {
+            float x0 = static_cast<float>(penX);
+            float y0 = static_cast<float>(y);
+            float x1 = x0 + glyph->src.w;
+            float y1 = y0 + glyph->src.h;
+            float u0 = glyph->src.x * invWidth;
+            float v0 = glyph->src.y * invHeight;
+            float u1 = (glyph->src.x + glyph->src.w) * invWidth;
+            float v1 = (glyph->src.y + glyph->src.h) * invHeight;
+
+            int base = static_cast<int>(vertices.size());
+            vertices.push_back({ { x0, y0 }, color, { u0, v0 } });
+            vertices.push_back({ { x1, y0 }, color, { u1, v0 } });
+            vertices.push_back({ { x1, y1 }, color, { u1, v1 } });
+            vertices.push_back({ { x0, y1 }, color, { u0, v1 } });
+
+            indices.push_back(base);
+            indices.push_back(base + 1);
+            indices.push_back(base + 2);
+            indices.push_back(base);
+            indices.push_back(base + 2);
+            indices.push_back(base + 3);
+        }
+        penX += glyph->advance;
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include "SDL.h"
+#include "SDL_ttf.h"
+#include "Renderer.h"
+#include <string>
+#include <vector>
+
+//atlas znaków ASCII wypiekany raz z czcionki do jednej tekstury
+class GlyphAtlas {
+public:
+    GlyphAtlas();
+    ~GlyphAtlas();
+
+    //bake nie potrzebuje renderera, więc może iść na innym wątku niż upload
+    bool bake(SDL_RWops* fontData, int fontSize); // przejmuje fontData, także przy błędzie
+    bool upload(Renderer& renderer);
+    void release(Renderer& renderer);
+    bool isLoaded() const;
+
+    void measure(const std::string& message, int* width, int* height) const;
+    void layout(const std::string& message, const SDL_Color& color, int x, int y,
+        std::vector<SDL_Vertex>& vertices, std::vector<int>& indices) const;
+
+    TextureId getTexture() const;
+
+private:
+    struct Glyph {
+        SDL_Rect src;
+        int advance;
+    };
+
+    static constexpr int FIRST_CHAR = 32;
+    static constexpr int LAST_CHAR = 126;
+    static constexpr int ATLAS_WIDTH = 512;
+
+    const Glyph* findGlyph(char c) const;
+
+    TextureId texture;
+    SDL_Surface* baked; // atlas czekający na upload
+    int atlasHeight;
+    int lineHeight;
+    Glyph glyphs[LAST_CHAR - FIRST_CHAR + 1];
+};
+
+#endif
+#pragma once
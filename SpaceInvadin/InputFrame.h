@@ -0,0 +1,23 @@
+#ifndef INPUT_FRAME_H
+#define INPUT_FRAME_H
+
+#include "SDL.h"
+
+//przyciski wciśnięte w jednym ticku symulacji
+enum InputButton {
+    INPUT_LEFT = 1 << 0,
+    INPUT_RIGHT = 1 << 1,
+    INPUT_FIRE = 1 << 2
+};
+
+//wszystko co symulacja dostaje z klawiatury w jednym ticku, tyle zapisuje nagranie
+struct InputFrame {
+    Uint8 buttons = 0;
+
+    bool has(InputButton button) const {
+        return (buttons & button) != 0;
+    }
+};
+
+#endif
+#pragma once
@@ -0,0 +1,91 @@
+#include "InputSystem.h"
+
+namespace {
+    //SDL_TICKS_PASSED dla znaczników w ms, odporne na przekręcenie licznika po 49 dniach
+    bool notAfter(Uint32 timestamp, Uint32 limit) {
+        return static_cast<Sint32>(limit - timestamp) >= 0;
+    }
+}
+
+InputSystem::InputSystem()
+    : heldButtons(0), quit(false) {
+}
+
+void InputSystem::install() {
+    SDL_SetEventFilter(&InputSystem::filterEvent, nullptr);
+}
+//wołane przez SDL przed dopisaniem zdarzenia do kolejki, także z innych wątków, więc bez stanu
+int SDLCALL InputSystem::filterEvent(void* /*userdata*/, SDL_Event* event) {
+    switch (event->type) {
+    case SDL_QUIT:
+    case SDL_WINDOWEVENT:
+        return 1;
+    case SDL_KEYDOWN:
+        return event->key.repeat ? 0 : 1;
+    default:
+        return 0;
+    }
+}
+//spacja to akcja ticka, reszta klawiszy idzie do sceny
+void InputSystem::pump() {
+    // SDL_PollEvent potrafi stać (np. przeciąganie okna w Windows), więc zdarzenia są zbierane przed blokadą
+    SDL_Event event;
+    events.clear();
+    while (SDL_PollEvent(&event)) {
+        events.push_back(event);
+    }
+    const Uint8* keys = SDL_GetKeyboardState(nullptr);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const SDL_Event& polled : events) {
+        if (polled.type == SDL_QUIT) {
+            quit = true;
+        }
+        else if (polled.type == SDL_KEYDOWN && !polled.key.repeat) {
+            if (polled.key.keysym.sym == SDLK_SPACE) {
+                actionPresses.push_back(ActionPress{ INPUT_FIRE, polled.key.timestamp });
+            }
+            else {
+                keyPresses.push_back(KeyPress{ polled.key.keysym.sym, polled.key.timestamp });
+            }
+        }
+    }
+    heldButtons = 0;
+    if (keys[SDL_SCANCODE_LEFT]) {
+        heldButtons |= INPUT_LEFT;
+    }
+    if (keys[SDL_SCANCODE_RIGHT]) {
+        heldButtons |= INPUT_RIGHT;
+    }
+}
+
+bool InputSystem::quitRequested() const {
+    return quit;
+}
+
+bool InputSystem::nextKeyPress(KeyPress* press) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (keyPresses.empty()) {
+        return false;
+    }
+    *press = keyPresses.front();
+    keyPresses.pop_front();
+    return true;
+}
+
+InputFrame InputSystem::sampleTick(Uint32 tickEnd) {
+    InputFrame input;
+    std::lock_guard<std::mutex> lock(mutex);
+    input.buttons = heldButtons;
+    // jedno wciśnięcie na tick: dwa szybkie strzały w czasie jednego ticka idą w dwóch kolejnych
+    if (!actionPresses.empty() && notAfter(actionPresses.front().timestamp, tickEnd)) {
+        input.buttons |= actionPresses.front().button;
+        actionPresses.pop_front();
+    }
+    return input;
+}
+
+void InputSystem::clearActions() {
+    std::lock_guard<std::mutex> lock(mutex);
+    actionPresses.clear();
+}
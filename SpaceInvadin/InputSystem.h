@@ -0,0 +1,54 @@
+#ifndef INPUT_SYSTEM_H
+#define INPUT_SYSTEM_H
+
+#include "SDL.h"
+#include "InputFrame.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+//wciśnięcie klawisza z czasem zdarzenia SDL (ms od SDL_Init, ten sam zegar co SDL_GetTicks)
+struct KeyPress {
+    SDL_Keycode key;
+    Uint32 timestamp;
+};
+
+//warstwa wejścia: ruch to klawisze trzymane, czytane z SDL_GetKeyboardState raz na tick, więc nie zależy od
+//opóźnienia i tempa autopowtarzania systemu; wciśnięcia (strzał, menu) idą do kolejek ze znacznikiem czasu,
+//strzał trafia do ticka, w którego czasie padł, a klawisze menu obsługuje scena w kolejności wciśnięć
+//pump woła wątek, który utworzył okno; resztę może wołać inny wątek (pętla gry przy FramePipeline)
+class InputSystem {
+public:
+    InputSystem();
+
+    //filtr zdarzeń SDL: do kolejki trafia tylko zamknięcie okna, zdarzenia okna i pierwsze wciśnięcie klawisza,
+    //bez autopowtórzeń, ruchu myszy, dotyku i tekstu; stan klawiatury SDL aktualizuje niezależnie od filtra
+    void install();
+
+    void pump(); // raz na klatkę: zdarzenia SDL do kolejek i stan trzymanych klawiszy
+    bool quitRequested() const;
+    bool nextKeyPress(KeyPress* press);
+
+    //wejście ticka kończącego się w chwili tickEnd (ms): ruch trzymany przy ostatnim pump i strzał, jeśli wciśnięto go do tickEnd
+    InputFrame sampleTick(Uint32 tickEnd);
+    void clearActions(); // wciśnięcia strzału sprzed pauzy nie trafiają do następnego ticka
+
+private:
+    struct ActionPress {
+        InputButton button;
+        Uint32 timestamp;
+    };
+
+    static int SDLCALL filterEvent(void* userdata, SDL_Event* event);
+
+    std::vector<SDL_Event> events; // tylko pump, bufor odebranych zdarzeń
+    std::mutex mutex; // kolejki i heldButtons
+    std::deque<KeyPress> keyPresses;
+    std::deque<ActionPress> actionPresses;
+    Uint8 heldButtons; // SDL_GetKeyboardState zmienia się tylko w pump, więc kopia z pump jest tym samym stanem
+    std::atomic<bool> quit;
+};
+
+#endif
+#pragma once
@@ -0,0 +1,211 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace {
+    //system i numer wątku roboczego, na którym działa bieżący wątek; wątki spoza systemu to wątek 0
+    thread_local const JobSystem* ownerSystem = nullptr;
+    thread_local int ownerIndex = 0;
+
+    const int IDLE_SPINS = 64; // tyle prób przed uśpieniem, zadania jednego ticka przychodzą seriami
+}
+
+JobGraph::JobGraph()
+    : unfinished(0) {
+}
+
+int JobGraph::add(Work work) {
+    std::unique_ptr<Node> node(new Node());
+    node->work = std::move(work);
+    node->dependencyCount = 0;
+    node->remaining.store(0);
+    node->graph = this;
+    nodes.push_back(std::move(node));
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void JobGraph::depend(int job, int on) {
+    nodes[on]->dependents.push_back(job);
+    nodes[job]->dependencyCount++;
+}
+
+int JobGraph::size() const {
+    return static_cast<int>(nodes.size());
+}
+
+JobSystem::JobSystem(int threadCount)
+    : queued(0), stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (int i = 1; i < threadCount; ++i) {
+        threads.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+int JobSystem::getThreadCount() const {
+    return static_cast<int>(queues.size());
+}
+//korzenie idą do kolejki wołającego, reszta do kolejki wątku, który zakończył ostatniego poprzednika
+void JobSystem::run(JobGraph& graph) {
+    if (graph.nodes.empty()) {
+        return;
+    }
+    int worker = currentWorker();
+    graph.unfinished.store(graph.size(), std::memory_order_relaxed);
+    for (auto& node : graph.nodes) {
+        node->remaining.store(node->dependencyCount, std::memory_order_relaxed);
+    }
+    for (auto& node : graph.nodes) {
+        if (node->dependencyCount == 0) {
+            push(worker, Task{ node.get(), nullptr, 0, 0, nullptr });
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_all();
+    waitFor(graph.unfinished, worker);
+}
+
+void JobSystem::parallelFor(int count, int grain, const RangeWork& work) {
+    if (count <= 0) {
+        return;
+    }
+    grain = std::max(grain, 1);
+    int worker = currentWorker();
+    int chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || threads.empty()) {
+        for (int begin = 0; begin < count; begin += grain) {
+            work(begin, std::min(begin + grain, count), worker);
+        }
+        return;
+    }
+
+    std::atomic<int> pending(chunks);
+    for (int begin = 0; begin < count; begin += grain) {
+        push(worker, Task{ nullptr, &work, begin, std::min(begin + grain, count), &pending });
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_all();
+    waitFor(pending, worker);
+}
+
+int JobSystem::currentWorker() const {
+    return ownerSystem == this ? ownerIndex : 0;
+}
+
+void JobSystem::push(int worker, const Task& task) {
+    WorkerQueue& queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(task);
+    queued.fetch_add(1);
+}
+//własna kolejka od końca: najświeższe zadanie ma jeszcze dane w pamięci podręcznej
+bool JobSystem::pop(int worker, Task* task) {
+    WorkerQueue& queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    *task = queue.tasks.back();
+    queue.tasks.pop_back();
+    queued.fetch_sub(1);
+    return true;
+}
+//cudze kolejki od początku, zaczynając od sąsiada, żeby złodzieje nie rzucali się na tę samą ofiarę
+bool JobSystem::steal(int worker, Task* task) {
+    int count = getThreadCount();
+    for (int i = 1; i < count; ++i) {
+        WorkerQueue& queue = *queues[(worker + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            *task = queue.tasks.front();
+            queue.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::runOne(int worker) {
+    Task task;
+    if (!pop(worker, &task) && !steal(worker, &task)) {
+        return false;
+    }
+    execute(worker, task);
+    return true;
+}
+//licznik oczekującego jest zmniejszany na samym końcu, bo po nim wołający może już zwolnić graf lub pracę parallelFor
+void JobSystem::execute(int worker, const Task& task) {
+    if (task.range) {
+        (*task.range)(task.begin, task.end, worker);
+        task.pending->fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    JobGraph::Node* node = task.node;
+    node->work(worker);
+    JobGraph& graph = *node->graph;
+    bool released = false;
+    for (int dependent : node->dependents) {
+        JobGraph::Node* next = graph.nodes[dependent].get();
+        if (next->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            push(worker, Task{ next, nullptr, 0, 0, nullptr });
+            released = true;
+        }
+    }
+    if (released) {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wake.notify_all();
+    }
+    graph.unfinished.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::waitFor(const std::atomic<int>& pending, int worker) {
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!runOne(worker)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(int worker) {
+    ownerSystem = this;
+    ownerIndex = worker;
+    while (true) {
+        bool ran = false;
+        for (int spin = 0; spin < IDLE_SPINS && !ran; ++spin) {
+            ran = runOne(worker);
+            if (!ran) {
+                std::this_thread::yield();
+            }
+        }
+        if (ran) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return queued.load() > 0 || stopping.load(); });
+        if (stopping.load() && queued.load() == 0) {
+            return;
+        }
+    }
+}
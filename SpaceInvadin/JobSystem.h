@@ -0,0 +1,93 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//zadania jednego przebiegu z jawnymi zależnościami: zadanie startuje, gdy licznik jego niezakończonych poprzedników spadnie do zera
+//graf jest budowany przed JobSystem::run i nie może być zmieniany w trakcie
+class JobGraph {
+public:
+    typedef std::function<void(int worker)> Work;
+
+    JobGraph();
+    JobGraph(const JobGraph&) = delete;
+    JobGraph& operator=(const JobGraph&) = delete;
+
+    int add(Work work);
+    void depend(int job, int on); // job zacznie się dopiero po zakończeniu on
+    int size() const;
+
+private:
+    friend class JobSystem;
+
+    struct Node {
+        Work work;
+        std::vector<int> dependents;
+        int dependencyCount;
+        std::atomic<int> remaining;
+        JobGraph* graph;
+    };
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::atomic<int> unfinished;
+};
+
+//mały system zadań z podkradaniem pracy: każdy wątek ma własną kolejkę, z której bierze od końca,
+//a bezczynny wątek kradnie z początku kolejek innych; czekanie (run, parallelFor) nie śpi, tylko wykonuje cudze zadania,
+//więc parallelFor można wołać także z wnętrza zadania
+//wątek wołający spoza systemu pracuje jako wątek 0; naraz może go używać tylko jeden taki wątek
+class JobSystem {
+public:
+    typedef std::function<void(int begin, int end, int worker)> RangeWork;
+
+    explicit JobSystem(int threadCount = 0); // razem z wołającym; 0 = tyle, ile rdzeni, 1 = wszystko na wołającym
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int getThreadCount() const;
+
+    void run(JobGraph& graph);
+    //dzieli [0, count) na kawałki po grain (ostatni krótszy) i czeka na wszystkie; granice kawałków to wielokrotności grain
+    void parallelFor(int count, int grain, const RangeWork& work);
+
+private:
+    struct Task {
+        JobGraph::Node* node;       // zadanie grafu albo
+        const RangeWork* range;     // kawałek parallelFor
+        int begin;
+        int end;
+        std::atomic<int>* pending;  // dla kawałka: licznik jego parallelFor
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    int currentWorker() const;
+    void push(int worker, const Task& task);
+    bool pop(int worker, Task* task);
+    bool steal(int worker, Task* task);
+    bool runOne(int worker);
+    void execute(int worker, const Task& task);
+    void waitFor(const std::atomic<int>& pending, int worker);
+    void workerLoop(int worker);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<int> queued;
+    std::atomic<bool> stopping;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+};
+
+#endif
+#pragma once
@@ -0,0 +1,226 @@
+#include "Leaderboard.h"
+#include "Crc32.h"
+#include "MappedFile.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstring>
+
+constexpr int Leaderboard::TOP_SIZE;
+constexpr int Leaderboard::SCORE_STEP;
+constexpr int Leaderboard::SCORE_BUCKETS;
+
+namespace {
+    const size_t RECORD_SIZE = 8 + 4 + 4 + 4 + 4; // czas, wynik, poziom, długość gry, CRC
+    const char INDEX_MAGIC[4] = { 'S', 'I', 'L', 'X' };
+    const Uint16 INDEX_VERSION = 2; // 1 zapisywał całe drzewo, 256 KiB przy każdym wyniku
+    const size_t INDEX_HEADER_SIZE = 4 + 2 + 2 + 4 + 4 + 4 + 4;
+
+    void putLittleEndian(std::vector<Uint8>& out, Uint64 value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<Uint8>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    Uint64 getLittleEndian(const Uint8* data, int bytes) {
+        Uint64 value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<Uint64>(data[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    void encodeRecord(const LeaderboardEntry& entry, std::vector<Uint8>& out) {
+        size_t start = out.size();
+        putLittleEndian(out, static_cast<Uint64>(entry.timestamp), 8);
+        putLittleEndian(out, static_cast<Uint32>(entry.score), 4);
+        putLittleEndian(out, static_cast<Uint32>(entry.level), 4);
+        putLittleEndian(out, entry.durationMs, 4);
+        putLittleEndian(out, crc32(out.data() + start, RECORD_SIZE - 4), 4);
+    }
+
+    bool decodeRecord(const Uint8* data, LeaderboardEntry* entry) {
+        if (crc32(data, RECORD_SIZE - 4) != getLittleEndian(data + RECORD_SIZE - 4, 4)) {
+            return false;
+        }
+        entry->timestamp = static_cast<Sint64>(getLittleEndian(data, 8));
+        entry->score = static_cast<Sint32>(getLittleEndian(data + 8, 4));
+        entry->level = static_cast<Sint32>(getLittleEndian(data + 12, 4));
+        entry->durationMs = static_cast<Uint32>(getLittleEndian(data + 16, 4));
+        return true;
+    }
+
+    int bucketOf(int score) {
+        if (score < 0) {
+            return 0;
+        }
+        return std::min(score / Leaderboard::SCORE_STEP, Leaderboard::SCORE_BUCKETS - 1);
+    }
+}
+
+Leaderboard::Leaderboard() {
+    reset();
+}
+
+void Leaderboard::reset() {
+    tree.assign(SCORE_BUCKETS, 0);
+    buckets.clear();
+    top.clear();
+    count = 0;
+    indexedRecords = 0;
+    entriesSize = 0;
+}
+//indeks z mapowania jest kopiowany do pamięci, bo każdy nowy wynik zmienia kilka węzłów drzewa
+void Leaderboard::open(const std::string& entriesFile, const std::string& indexFile) {
+    TRACE_ZONE("leaderboard open");
+    reset();
+    MappedFile index;
+    if (index.open(indexFile) && !loadIndex(index.getData(), index.getSize())) {
+        SDL_Log("Rebuilding leaderboard index %s", indexFile.c_str());
+        reset();
+    }
+    index.close();
+
+    MappedFile entries;
+    entriesSize = entries.open(entriesFile) ? entries.getSize() : 0;
+    Uint32 records = static_cast<Uint32>(entriesSize / RECORD_SIZE);
+    if (indexedRecords > records) {
+        SDL_Log("Leaderboard index is ahead of %s, rebuilding", entriesFile.c_str());
+        reset();
+    }
+    for (Uint32 i = indexedRecords; i < records; ++i) {
+        LeaderboardEntry entry;
+        if (decodeRecord(entries.getData() + i * RECORD_SIZE, &entry)) {
+            insert(entry);
+        }
+    }
+    indexedRecords = records;
+}
+//rekord po urwanym poprzednim zaczyna się od pełnej wielokrotności RECORD_SIZE, resztka staje się uszkodzonym rekordem
+int Leaderboard::add(const LeaderboardEntry& entry, std::vector<Uint8>* entryBytes, std::vector<Uint8>* indexBytes) {
+    size_t padding = static_cast<size_t>((RECORD_SIZE - entriesSize % RECORD_SIZE) % RECORD_SIZE);
+    entryBytes->assign(padding, 0);
+    encodeRecord(entry, *entryBytes);
+    entriesSize += entryBytes->size();
+    indexedRecords = static_cast<Uint32>(entriesSize / RECORD_SIZE);
+
+    insert(entry);
+    encodeIndex(indexBytes);
+    return rankOf(entry.score);
+}
+
+int Leaderboard::rankOf(int score) const {
+    return 1 + static_cast<int>(count - countUpTo(bucketOf(score)));
+}
+
+Uint32 Leaderboard::getCount() const {
+    return count;
+}
+
+int Leaderboard::getBestScore() const {
+    return top.empty() ? 0 : top.front().score;
+}
+
+const std::vector<LeaderboardEntry>& Leaderboard::getTop() const {
+    return top;
+}
+//przy remisie starszy wynik zostaje wyżej
+void Leaderboard::insert(const LeaderboardEntry& entry) {
+    int bucket = bucketOf(entry.score);
+    for (int i = bucket + 1; i <= SCORE_BUCKETS; i += i & -i) {
+        tree[i - 1]++;
+    }
+    count++;
+
+    auto counted = std::lower_bound(buckets.begin(), buckets.end(), static_cast<Uint32>(bucket),
+        [](const BucketCount& a, Uint32 b) { return a.bucket < b; });
+    if (counted != buckets.end() && counted->bucket == static_cast<Uint32>(bucket)) {
+        counted->count++;
+    }
+    else {
+        buckets.insert(counted, BucketCount{ static_cast<Uint32>(bucket), 1 });
+    }
+
+    auto position = std::upper_bound(top.begin(), top.end(), entry,
+        [](const LeaderboardEntry& a, const LeaderboardEntry& b) { return a.score > b.score; });
+    if (position - top.begin() < TOP_SIZE) {
+        top.insert(position, entry);
+        if (static_cast<int>(top.size()) > TOP_SIZE) {
+            top.pop_back();
+        }
+    }
+}
+//liczba wyników w przedziałach 0..bucket
+Uint32 Leaderboard::countUpTo(int bucket) const {
+    Uint32 sum = 0;
+    for (int i = bucket + 1; i > 0; i -= i & -i) {
+        sum += tree[i - 1];
+    }
+    return sum;
+}
+
+bool Leaderboard::loadIndex(const Uint8* data, size_t size) {
+    if (size < INDEX_HEADER_SIZE || std::memcmp(data, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+        getLittleEndian(data + 4, 2) != INDEX_VERSION || getLittleEndian(data + 6, 2) != INDEX_HEADER_SIZE) {
+        return false;
+    }
+    Uint32 records = static_cast<Uint32>(getLittleEndian(data + 8, 4));
+    Uint32 bucketCount = static_cast<Uint32>(getLittleEndian(data + 12, 4));
+    Uint32 topCount = static_cast<Uint32>(getLittleEndian(data + 16, 4));
+    Uint32 storedCrc = static_cast<Uint32>(getLittleEndian(data + 20, 4));
+    if (bucketCount > SCORE_BUCKETS || topCount > TOP_SIZE ||
+        size != INDEX_HEADER_SIZE + topCount * RECORD_SIZE + static_cast<size_t>(bucketCount) * 8 ||
+        crc32(data + INDEX_HEADER_SIZE, size - INDEX_HEADER_SIZE) != storedCrc) {
+        return false;
+    }
+
+    const Uint8* cursor = data + INDEX_HEADER_SIZE;
+    for (Uint32 i = 0; i < topCount; ++i, cursor += RECORD_SIZE) {
+        LeaderboardEntry entry;
+        if (!decodeRecord(cursor, &entry)) {
+            return false;
+        }
+        top.push_back(entry);
+    }
+    //przedziały rosną i nie są puste; liczniki idą do drzewa od liści, a budowa w miejscu daje O(n)
+    for (Uint32 i = 0; i < bucketCount; ++i, cursor += 8) {
+        BucketCount counted = { static_cast<Uint32>(getLittleEndian(cursor, 4)), static_cast<Uint32>(getLittleEndian(cursor + 4, 4)) };
+        if (counted.bucket >= SCORE_BUCKETS || counted.count == 0 || (!buckets.empty() && counted.bucket <= buckets.back().bucket)) {
+            return false;
+        }
+        buckets.push_back(counted);
+        tree[counted.bucket] = counted.count;
+        count += counted.count;
+    }
+    for (int i = 1; i <= SCORE_BUCKETS; ++i) {
+        int parent = i + (i & -i);
+        if (parent <= SCORE_BUCKETS) {
+            tree[parent - 1] += tree[i - 1];
+        }
+    }
+    indexedRecords = records;
+    return true;
+}
+
+void Leaderboard::encodeIndex(std::vector<Uint8>* out) const {
+    out->clear();
+    out->reserve(INDEX_HEADER_SIZE + top.size() * RECORD_SIZE + buckets.size() * 8);
+    out->insert(out->end(), INDEX_MAGIC, INDEX_MAGIC + sizeof(INDEX_MAGIC));
+    putLittleEndian(*out, INDEX_VERSION, 2);
+    putLittleEndian(*out, INDEX_HEADER_SIZE, 2);
+    putLittleEndian(*out, indexedRecords, 4);
+    putLittleEndian(*out, buckets.size(), 4);
+    putLittleEndian(*out, top.size(), 4);
+    putLittleEndian(*out, 0, 4); // CRC uzupełniane po zapisaniu danych
+
+    for (const auto& entry : top) {
+        encodeRecord(entry, *out);
+    }
+    for (const auto& counted : buckets) {
+        putLittleEndian(*out, counted.bucket, 4);
+        putLittleEndian(*out, counted.count, 4);
+    }
+    Uint32 crc = crc32(out->data() + INDEX_HEADER_SIZE, out->size() - INDEX_HEADER_SIZE);
+    for (int i = 0; i < 4; ++i) {
+        (*out)[20 + i] = static_cast<Uint8>((crc >> (8 * i)) & 0xFF);
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include "SDL.h"
+#include <string>
+#include <vector>
+
+//jedna zakończona gra
+struct LeaderboardEntry {
+    Sint64 timestamp; // sekundy od 1970, 0 gdy nieznany
+    Sint32 score;
+    Sint32 level;
+    Uint32 durationMs;
+};
+
+//tablica wyników w dwóch plikach:
+//- plik wyników tylko dopisywany, rekordy po 24 bajty z własnym CRC (urwany rekord jest pomijany)
+//- indeks podmieniany w całości: liczniki tylko niepustych przedziałów po SCORE_STEP punktów i gotowa dziesiątka
+//  najlepszych, więc ma rozmiar rzędu liczby różnych wyników, a nie wszystkich przedziałów; w pamięci liczniki
+//  tworzą drzewo Fenwicka, więc miejsce i top 10 są w O(log n) bez czytania historii
+//indeks pamięta, ile rekordów już objął; przy otwarciu doindeksowywany jest tylko ogon pliku wyników
+//wyniki od SCORE_STEP * (SCORE_BUCKETS - 1) wzwyż trafiają do ostatniego przedziału: rankOf daje im wspólne
+//pierwsze miejsce, a top 10 dalej porządkuje je dokładnie
+class Leaderboard {
+public:
+    static constexpr int TOP_SIZE = 10;
+    static constexpr int SCORE_STEP = 10;
+    static constexpr int SCORE_BUCKETS = 1 << 16;
+
+    Leaderboard();
+
+    void open(const std::string& entriesFile, const std::string& indexFile);
+
+    //dodaje wynik i zwraca jego miejsce; entryBytes trzeba dopisać do pliku wyników, indexBytes zastępują indeks
+    int add(const LeaderboardEntry& entry, std::vector<Uint8>* entryBytes, std::vector<Uint8>* indexBytes);
+
+    int rankOf(int score) const; // 1 + liczba wyników z wyższych przedziałów, remisy dzielą miejsce
+    Uint32 getCount() const;
+    int getBestScore() const;
+    const std::vector<LeaderboardEntry>& getTop() const;
+
+private:
+    //niepusty przedział wyników w indeksie
+    struct BucketCount {
+        Uint32 bucket;
+        Uint32 count;
+    };
+
+    void reset();
+    void insert(const LeaderboardEntry& entry);
+    Uint32 countUpTo(int bucket) const;
+    bool loadIndex(const Uint8* data, size_t size);
+    void encodeIndex(std::vector<Uint8>* out) const;
+
+    std::vector<Uint32> tree; // drzewo Fenwicka, tree[i - 1] odpowiada węzłowi i
+    std::vector<BucketCount> buckets; // rosnąco po przedziale, tylko do zapisu indeksu
+    std::vector<LeaderboardEntry> top;
+    Uint32 count;
+    Uint32 indexedRecords; // rekordy pliku wyników objęte indeksem, także uszkodzone
+    Uint64 entriesSize;
+};
+
+#endif
+#pragma once
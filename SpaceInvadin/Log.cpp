@@ -0,0 +1,315 @@
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+constexpr int LogRecord::MAX_ARGS;
+constexpr size_t LogRecord::TEXT_SIZE;
+constexpr size_t Logger::CAPACITY;
+
+namespace {
+    //fopen jest pod /sdl błędem C4996, MSVC wymaga fopen_s
+    FILE* openFile(const std::string& filename, const char* mode) {
+#ifdef _WIN32
+        FILE* file = nullptr;
+        return fopen_s(&file, filename.c_str(), mode) == 0 ? file : nullptr;
+#else
+        return std::fopen(filename.c_str(), mode);
+#endif
+    }
+
+    const char* const LEVEL_NAMES[] = { "trace", "debug", "info", "warn", "error" };
+    const char* const CATEGORY_NAMES[LOG_CATEGORY_COUNT] = { "game", "sim", "io", "render" };
+
+    //formatuje jeden specyfikator printf z jednym argumentem; modyfikatory długości są podmieniane
+    //na te pasujące do zapisanego typu, więc %d z Uint64 czy %u z int nie czyta śmieci
+    void formatArg(std::string& out, std::string spec, char conversion, const LogArg* arg, const LogRecord& record) {
+        char buffer[128];
+        int written = 0;
+        bool integral = std::strchr("diouxXc", conversion) != nullptr;
+        bool floating = std::strchr("fFeEgGaA", conversion) != nullptr;
+        if (!arg) {
+            out += "<?>";
+            return;
+        }
+        if (integral) {
+            Sint64 value = arg->type == LogArg::ARG_DOUBLE ? static_cast<Sint64>(arg->d) : arg->i;
+            if (conversion == 'c') {
+                spec += 'c';
+                written = std::snprintf(buffer, sizeof(buffer), spec.c_str(), static_cast<int>(value));
+            }
+            else if (conversion == 'd' || conversion == 'i') {
+                spec += "lld";
+                written = std::snprintf(buffer, sizeof(buffer), spec.c_str(), static_cast<long long>(value));
+            }
+            else {
+                spec += "ll";
+                spec += conversion;
+                written = std::snprintf(buffer, sizeof(buffer), spec.c_str(), static_cast<unsigned long long>(value));
+            }
+        }
+        else if (floating) {
+            spec += conversion;
+            double value = arg->type == LogArg::ARG_DOUBLE ? arg->d :
+                arg->type == LogArg::ARG_UINT ? static_cast<double>(arg->u) : static_cast<double>(arg->i);
+            written = std::snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+        }
+        else if (conversion == 's' && arg->type == LogArg::ARG_STRING) {
+            spec += 's';
+            written = std::snprintf(buffer, sizeof(buffer), spec.c_str(), record.text + arg->offset);
+        }
+        else if (conversion == 'p') {
+            spec += 'p';
+            written = std::snprintf(buffer, sizeof(buffer), spec.c_str(), arg->p);
+        }
+        else {
+            out += "<?>";
+            return;
+        }
+        if (written > 0) {
+            out.append(buffer, std::min(static_cast<size_t>(written), sizeof(buffer) - 1));
+        }
+    }
+
+    void formatRecord(const LogRecord& record, std::string& out) {
+        out.clear();
+        int nextArg = 0;
+        const char* cursor = record.format;
+        while (*cursor) {
+            const char* percent = std::strchr(cursor, '%');
+            if (!percent) {
+                out += cursor;
+                break;
+            }
+            out.append(cursor, percent - cursor);
+            if (percent[1] == '%') {
+                out += '%';
+                cursor = percent + 2;
+                continue;
+            }
+            std::string spec = "%";
+            const char* p = percent + 1;
+            while (*p && std::strchr("-+ #0123456789.", *p)) {
+                spec += *p++;
+            }
+            while (*p && std::strchr("hlLzjtq", *p)) {
+                p++; // długość wynika z zapisanego typu
+            }
+            if (!*p) {
+                break;
+            }
+            const LogArg* arg = nextArg < record.argCount ? &record.args[nextArg] : nullptr;
+            nextArg++;
+            formatArg(out, spec, *p, arg, record);
+            cursor = p + 1;
+        }
+    }
+}
+
+LogSink::~LogSink() {
+}
+
+void LogSink::flush() {
+}
+
+void ConsoleLogSink::write(LogLevel level, LogCategory category, double seconds, const char* message) {
+    SDL_Log("%9.3f %-5s %-6s %s", seconds, LEVEL_NAMES[level], CATEGORY_NAMES[category], message);
+}
+
+FileLogSink::FileLogSink(const std::string& filename)
+    : file(openFile(filename, "a")) {
+}
+
+FileLogSink::~FileLogSink() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool FileLogSink::isOpen() const {
+    return file != nullptr;
+}
+
+void FileLogSink::write(LogLevel level, LogCategory category, double seconds, const char* message) {
+    if (file) {
+        std::fprintf(file, "%9.3f %-5s %-6s %s\n", seconds, LEVEL_NAMES[level], CATEGORY_NAMES[category], message);
+    }
+}
+
+void FileLogSink::flush() {
+    if (file) {
+        std::fflush(file);
+    }
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger()
+    : slots(new Slot[CAPACITY]), enqueuePos(0), dequeuePos(0), dropped(0), running(false), stopping(false) {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    setLevel(LEVEL_INFO);
+}
+
+Logger::~Logger() {
+    stop();
+}
+
+void Logger::start(std::unique_ptr<LogSink> newSink) {
+    stop();
+    sink = std::move(newSink);
+    stopping.store(false);
+    running.store(true);
+    thread = std::thread(&Logger::workerLoop, this);
+}
+//najpierw wyłącza przyjmowanie wpisów, potem wątek wypisuje to, co już jest w pierścieniu
+void Logger::stop() {
+    if (!thread.joinable()) {
+        return;
+    }
+    running.store(false);
+    stopping.store(true);
+    thread.join();
+    if (dropped.load() > 0) {
+        SDL_Log("Logger dropped %llu records", static_cast<unsigned long long>(dropped.load()));
+    }
+    sink.reset();
+}
+
+void Logger::setLevel(LogLevel level) {
+    for (int i = 0; i < LOG_CATEGORY_COUNT; ++i) {
+        levels[i].store(level, std::memory_order_relaxed);
+    }
+}
+
+void Logger::setLevel(LogCategory category, LogLevel level) {
+    levels[category].store(level, std::memory_order_relaxed);
+}
+
+Uint64 Logger::getDropped() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+//slot jest wolny, gdy jego sekwencja równa się pozycji; inaczej czytający jeszcze go nie zwolnił, czyli pierścień jest pełny
+Logger::Slot* Logger::claim() {
+    size_t position = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Slot* slot = &slots[position & (CAPACITY - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                return slot;
+            }
+        }
+        else if (difference < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else {
+            position = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::publish(Slot* slot) {
+    size_t position = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+bool Logger::drainOne() {
+    Slot* slot = &slots[dequeuePos & (CAPACITY - 1)];
+    if (slot->sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+        return false; // pusty albo wpis jeszcze w trakcie zapisu
+    }
+
+    formatRecord(slot->record, message);
+    double seconds = static_cast<double>(slot->record.counter) / SDL_GetPerformanceFrequency();
+    LogLevel level = static_cast<LogLevel>(slot->record.level);
+    LogCategory category = static_cast<LogCategory>(slot->record.category);
+    slot->sequence.store(dequeuePos + CAPACITY, std::memory_order_release);
+    dequeuePos++;
+
+    sink->write(level, category, seconds, message.c_str());
+    return true;
+}
+//bez wpisów wątek śpi krótko zamiast czekać na zmiennej warunkowej, żeby wołający nie brali żadnej blokady
+void Logger::workerLoop() {
+    while (true) {
+        bool wrote = false;
+        while (drainOne()) {
+            wrote = true;
+        }
+        if (wrote) {
+            sink->flush();
+        }
+        else if (stopping.load()) {
+            return;
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+}
+
+LogArg* Logger::nextArg(LogRecord& record) {
+    if (record.argCount >= LogRecord::MAX_ARGS) {
+        return nullptr;
+    }
+    return &record.args[record.argCount++];
+}
+
+void Logger::storeSigned(LogRecord& record, Sint64 value) {
+    if (LogArg* arg = nextArg(record)) {
+        arg->type = LogArg::ARG_INT;
+        arg->i = value;
+    }
+}
+
+void Logger::storeUnsigned(LogRecord& record, Uint64 value) {
+    if (LogArg* arg = nextArg(record)) {
+        arg->type = LogArg::ARG_UINT;
+        arg->u = value;
+    }
+}
+
+void Logger::store(LogRecord& record, double value) {
+    if (LogArg* arg = nextArg(record)) {
+        arg->type = LogArg::ARG_DOUBLE;
+        arg->d = value;
+    }
+}
+//napis jest kopiowany od razu, bo wołający może go zwolnić przed sformatowaniem; za długi jest obcinany
+void Logger::store(LogRecord& record, const char* value) {
+    if (LogArg* arg = nextArg(record)) {
+        size_t space = LogRecord::TEXT_SIZE - record.textUsed;
+        size_t length = value ? std::min(std::strlen(value), space - 1) : 0;
+        arg->type = LogArg::ARG_STRING;
+        arg->offset = record.textUsed;
+        if (length > 0) {
+            std::memcpy(record.text + record.textUsed, value, length);
+        }
+        record.text[record.textUsed + length] = '\0';
+        record.textUsed = static_cast<Uint8>(std::min(record.textUsed + length + 1, LogRecord::TEXT_SIZE - 1));
+    }
+}
+
+void Logger::store(LogRecord& record, const void* value) {
+    if (LogArg* arg = nextArg(record)) {
+        arg->type = LogArg::ARG_POINTER;
+        arg->p = value;
+    }
+}
+
+bool parseLogLevel(const char* name, LogLevel* level) {
+    for (int i = LEVEL_TRACE; i <= LEVEL_ERROR; ++i) {
+        if (std::strcmp(name, LEVEL_NAMES[i]) == 0) {
+            *level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
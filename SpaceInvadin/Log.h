@@ -0,0 +1,206 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include "SDL.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+
+enum LogLevel {
+    LEVEL_TRACE = 0,
+    LEVEL_DEBUG = 1,
+    LEVEL_INFO = 2,
+    LEVEL_WARN = 3,
+    LEVEL_ERROR = 4
+};
+
+enum LogCategory {
+    LOG_GAME = 0,
+    LOG_SIM,
+    LOG_IO,
+    LOG_RENDER,
+    LOG_CATEGORY_COUNT
+};
+
+//wywołania poniżej LOG_COMPILED_LEVEL (liczba jak w LogLevel) znikają z kodu razem z wyliczaniem argumentów
+#ifndef LOG_COMPILED_LEVEL
+#ifdef NDEBUG
+#define LOG_COMPILED_LEVEL 2
+#else
+#define LOG_COMPILED_LEVEL 1
+#endif
+#endif
+
+//argument zapamiętany bez formatowania; napisy są kopiowane do bufora rekordu
+struct LogArg {
+    enum Type : Uint8 {
+        ARG_INT,
+        ARG_UINT,
+        ARG_DOUBLE,
+        ARG_STRING, // offset w LogRecord::text
+        ARG_POINTER
+    };
+    Type type;
+    union {
+        Sint64 i;
+        Uint64 u;
+        double d;
+        size_t offset;
+        const void* p;
+    };
+};
+
+//jeden wpis w kolejce; format musi być literałem, bo formatuje go dopiero wątek loggera
+struct LogRecord {
+    static constexpr int MAX_ARGS = 8;
+    static constexpr size_t TEXT_SIZE = 96;
+
+    Uint64 counter; // SDL_GetPerformanceCounter w chwili wywołania
+    const char* format;
+    Uint8 level;
+    Uint8 category;
+    Uint8 argCount;
+    Uint8 textUsed;
+    LogArg args[MAX_ARGS];
+    char text[TEXT_SIZE];
+};
+
+//miejsce docelowe sformatowanych wpisów; wywoływane tylko z wątku loggera
+class LogSink {
+public:
+    virtual ~LogSink();
+    virtual void write(LogLevel level, LogCategory category, double seconds, const char* message) = 0;
+    virtual void flush();
+};
+
+class ConsoleLogSink : public LogSink {
+public:
+    void write(LogLevel level, LogCategory category, double seconds, const char* message) override;
+};
+
+class FileLogSink : public LogSink {
+public:
+    explicit FileLogSink(const std::string& filename);
+    ~FileLogSink() override;
+    bool isOpen() const;
+    void write(LogLevel level, LogCategory category, double seconds, const char* message) override;
+    void flush() override;
+
+private:
+    FILE* file;
+};
+
+//logger asynchroniczny: wołający tylko rezerwuje slot w pierścieniu (jeden CAS), wpisuje argumenty i go publikuje,
+//formatowanie i wypisywanie robi osobny wątek; pełny pierścień gubi wpis zamiast czekać
+//pierścień to ograniczona kolejka Vyukova z numerem sekwencji w każdym slocie, wielu piszących, jeden czytający
+class Logger {
+public:
+    static constexpr size_t CAPACITY = 4096; // potęga dwójki
+
+    static Logger& instance();
+
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void start(std::unique_ptr<LogSink> sink);
+    void stop(); // wypisuje wszystko, co zostało w pierścieniu
+
+    void setLevel(LogLevel level); // dla wszystkich kategorii
+    void setLevel(LogCategory category, LogLevel level);
+
+    bool isEnabled(LogLevel level, LogCategory category) const {
+        return running.load(std::memory_order_relaxed) &&
+            level >= levels[category].load(std::memory_order_relaxed);
+    }
+
+    template <typename... Args>
+    void write(LogLevel level, LogCategory category, const char* format, const Args&... args) {
+        if (!isEnabled(level, category)) {
+            return;
+        }
+        Slot* slot = claim();
+        if (!slot) {
+            return;
+        }
+        LogRecord& record = slot->record;
+        record.counter = SDL_GetPerformanceCounter();
+        record.format = format;
+        record.level = static_cast<Uint8>(level);
+        record.category = static_cast<Uint8>(category);
+        record.argCount = 0;
+        record.textUsed = 0;
+        int expand[] = { 0, (store(record, args), 0)... };
+        (void)expand;
+        publish(slot);
+    }
+
+    Uint64 getDropped() const;
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    Slot* claim();
+    void publish(Slot* slot);
+    bool drainOne();
+    void workerLoop();
+
+    static LogArg* nextArg(LogRecord& record);
+    static void store(LogRecord& record, int value) { storeSigned(record, value); }
+    static void store(LogRecord& record, long value) { storeSigned(record, value); }
+    static void store(LogRecord& record, long long value) { storeSigned(record, value); }
+    static void store(LogRecord& record, unsigned value) { storeUnsigned(record, value); }
+    static void store(LogRecord& record, unsigned long value) { storeUnsigned(record, value); }
+    static void store(LogRecord& record, unsigned long long value) { storeUnsigned(record, value); }
+    static void store(LogRecord& record, double value);
+    static void store(LogRecord& record, const char* value);
+    static void store(LogRecord& record, const std::string& value) { store(record, value.c_str()); }
+    static void store(LogRecord& record, const void* value);
+    static void storeSigned(LogRecord& record, Sint64 value);
+    static void storeUnsigned(LogRecord& record, Uint64 value);
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<size_t> enqueuePos;
+    size_t dequeuePos; // tylko wątek loggera
+    std::atomic<Uint64> dropped;
+    std::atomic<int> levels[LOG_CATEGORY_COUNT];
+    std::atomic<bool> running;
+    std::atomic<bool> stopping;
+    std::unique_ptr<LogSink> sink;
+    std::string message; // bufor formatowania wątku loggera
+    std::thread thread;
+};
+
+#if LOG_COMPILED_LEVEL <= 0
+#define LOG_TRACE(category, ...) Logger::instance().write(LEVEL_TRACE, category, __VA_ARGS__)
+#else
+#define LOG_TRACE(category, ...) ((void)0)
+#endif
+#if LOG_COMPILED_LEVEL <= 1
+#define LOG_DEBUG(category, ...) Logger::instance().write(LEVEL_DEBUG, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) ((void)0)
+#endif
+#if LOG_COMPILED_LEVEL <= 2
+#define LOG_INFO(category, ...) Logger::instance().write(LEVEL_INFO, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) ((void)0)
+#endif
+#if LOG_COMPILED_LEVEL <= 3
+#define LOG_WARN(category, ...) Logger::instance().write(LEVEL_WARN, category, __VA_ARGS__)
+#else
+#define LOG_WARN(category, ...) ((void)0)
+#endif
+#define LOG_ERROR(category, ...) Logger::instance().write(LEVEL_ERROR, category, __VA_ARGS__)
+
+bool parseLogLevel(const char* name, LogLevel* level);
+
+#endif
+#pragma once
@@ -0,0 +1,33 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "SDL.h"
+#include <string>
+
+//plik zmapowany do pamięci tylko do odczytu (MapViewOfFile na Windows, mmap gdzie indziej)
+//dane są dostępne bez kopiowania do czasu close() albo zniszczenia obiektu
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const;
+
+    const Uint8* getData() const;
+    size_t getSize() const;
+
+private:
+    const Uint8* data;
+    size_t size;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+#endif
+#pragma once
@@ -0,0 +1,31 @@
+#include "NullRenderer.h"
+
+NullRenderer::NullRenderer()
+    : nextTexture(1) {
+}
+
+bool NullRenderer::initialize(const char* /*title*/, int /*width*/, int /*height*/) {
+    return true;
+}
+
+void NullRenderer::shutdown() {
+}
+//zwraca tylko identyfikator, piksele nigdzie nie trafiają
+TextureId NullRenderer::doCreateTexture(SDL_Surface* surface) {
+    return surface ? nextTexture++ : 0;
+}
+
+void NullRenderer::doDestroyTexture(TextureId /*texture*/) {
+}
+
+void NullRenderer::doClear(const SDL_Color& /*color*/) {
+}
+
+void NullRenderer::doFillRects(const SDL_Color& /*color*/, const SDL_Rect* /*rects*/, int /*count*/) {
+}
+
+void NullRenderer::doDrawGeometry(TextureId /*texture*/, const SDL_Vertex* /*vertices*/, int /*vertexCount*/, const int* /*indices*/, int /*indexCount*/) {
+}
+
+void NullRenderer::doPresent() {
+}
@@ -0,0 +1,27 @@
+#ifndef NULL_RENDERER_H
+#define NULL_RENDERER_H
+
+#include "Renderer.h"
+
+//backend bez rasteryzacji do trybu --headless, zbiera tylko statystyki rysowania
+class NullRenderer : public Renderer {
+public:
+    NullRenderer();
+
+    bool initialize(const char* title, int width, int height) override;
+    void shutdown() override;
+
+protected:
+    TextureId doCreateTexture(SDL_Surface* surface) override;
+    void doDestroyTexture(TextureId texture) override;
+    void doClear(const SDL_Color& color) override;
+    void doFillRects(const SDL_Color& color, const SDL_Rect* rects, int count) override;
+    void doDrawGeometry(TextureId texture, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount) override;
+    void doPresent() override;
+
+private:
+    TextureId nextTexture;
+};
+
+#endif
+#pragma once
@@ -1,23 +1,28 @@
 #include "Player.h"
 
 Player::Player(int startX, int startY, int width, int height, int moveSpeed)
-    : x(startX), y(startY), w(width), h(height), speed(moveSpeed), shooting(false) {
+    : x(startX), y(startY), w(width), h(height), prevX(startX), prevY(startY), speed(moveSpeed), shooting(false) {
 }
 
-void Player::moveLeft() {
+void Player::moveLeft(int distance) {
     if (x > 0) {
-        x -= speed;
+        x -= distance;
     }
 }
 
-void Player::moveRight() {
+void Player::moveRight(int distance) {
     if (x + w < 800) {
-        x += speed;
+        x += distance;
     }
 }
 
-void Player::render(SDL_Renderer* renderer) {
-    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-    SDL_Rect playerRect = { x, y, w, h };
-    SDL_RenderFillRect(renderer, &playerRect);
+void Player::storePosition() {
+    prevX = x;
+    prevY = y;
+}
+
+void Player::render(RenderQueue& queue, float alpha) const {
+    SDL_Color green = { 0, 255, 0, 255 };
+    SDL_Rect playerRect = { prevX + static_cast<int>((x - prevX) * alpha), prevY + static_cast<int>((y - prevY) * alpha), w, h };
+    queue.fillRect(playerRect, green);
 }
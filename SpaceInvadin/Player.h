@@ -2,17 +2,20 @@
 #define PLAYER_H
 
 #include "SDL.h"
+#include "RenderQueue.h"
 
 class Player {
 public:
     int x, y, w, h;
+    int prevX, prevY;
     int speed;
     bool shooting;
 
     Player(int startX, int startY, int width, int height, int moveSpeed);
-    void moveLeft();
-    void moveRight();
-    void render(SDL_Renderer* renderer);
+    void moveLeft(int distance);
+    void moveRight(int distance);
+    void render(RenderQueue& queue, float alpha) const;
+    void storePosition();
 };
 
 #endif
@@ -0,0 +1,124 @@
+#include "Profiler.h"
+
+#if PROFILER_ENABLED
+
+#include <algorithm>
+#include <cstring>
+
+constexpr int Profiler::HISTORY;
+constexpr int Profiler::BUCKETS;
+
+namespace {
+    //fopen jest pod /sdl błędem C4996, MSVC wymaga fopen_s
+    FILE* openFile(const std::string& filename, const char* mode) {
+#ifdef _WIN32
+        FILE* file = nullptr;
+        return fopen_s(&file, filename.c_str(), mode) == 0 ? file : nullptr;
+#else
+        return std::fopen(filename.c_str(), mode);
+#endif
+    }
+
+    const char* const PHASE_NAMES[PHASE_COUNT] = { "input", "update", "text", "render", "flush", "present", "frame" };
+    const float BUCKET_MS = 0.1f;
+
+    int bucketOf(float ms) {
+        return std::min(static_cast<int>(ms / BUCKET_MS), Profiler::BUCKETS - 1);
+    }
+}
+
+Profiler::Profiler()
+    : msPerTick(1000.0 / SDL_GetPerformanceFrequency()), frameStart(0), next(0), filled(0), frameIndex(0), csv(nullptr) {
+    std::memset(current, 0, sizeof(current));
+    std::memset(history, 0, sizeof(history));
+    std::memset(histogram, 0, sizeof(histogram));
+}
+
+Profiler::~Profiler() {
+    if (csv) {
+        std::fclose(csv);
+    }
+}
+
+bool Profiler::openCsv(const std::string& filename) {
+    csv = openFile(filename, "w");
+    if (!csv) {
+        SDL_Log("Failed to create %s", filename.c_str());
+        return false;
+    }
+    std::fprintf(csv, "frame");
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        std::fprintf(csv, ",%s_ms", PHASE_NAMES[phase]);
+    }
+    std::fprintf(csv, "\n");
+    return true;
+}
+
+void Profiler::beginFrame() {
+    std::memset(current, 0, sizeof(current));
+    frameStart = SDL_GetPerformanceCounter();
+}
+//zamyka klatkę: nowa wartość każdej fazy zastępuje w pierścieniu i histogramie najstarszą
+void Profiler::endFrame() {
+    current[PHASE_FRAME] = SDL_GetPerformanceCounter() - frameStart;
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        float ms = static_cast<float>(current[phase] * msPerTick);
+        if (filled == HISTORY) {
+            histogram[phase][bucketOf(history[phase][next])]--;
+        }
+        history[phase][next] = ms;
+        histogram[phase][bucketOf(ms)]++;
+    }
+    next = (next + 1) % HISTORY;
+    filled = std::min(filled + 1, HISTORY);
+
+    if (csv) {
+        std::fprintf(csv, "%llu", static_cast<unsigned long long>(frameIndex));
+        for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+            std::fprintf(csv, ",%.3f", current[phase] * msPerTick);
+        }
+        std::fprintf(csv, "\n");
+    }
+    frameIndex++;
+}
+
+PhaseStats Profiler::getStats(ProfilePhase phase) const {
+    PhaseStats stats = {};
+    if (filled == 0) {
+        return stats;
+    }
+    stats.lastMs = history[phase][(next + HISTORY - 1) % HISTORY];
+    stats.p50Ms = percentile(phase, 0.50f);
+    stats.p99Ms = percentile(phase, 0.99f);
+    stats.maxMs = *std::max_element(history[phase], history[phase] + filled);
+    return stats;
+}
+
+float Profiler::getFrameMs(int age) const {
+    if (age >= filled) {
+        return 0.0f;
+    }
+    return history[PHASE_FRAME][(next + HISTORY - 1 - age) % HISTORY];
+}
+
+int Profiler::getFrameCount() const {
+    return filled;
+}
+
+const char* Profiler::getPhaseName(ProfilePhase phase) {
+    return PHASE_NAMES[phase];
+}
+//górna granica przedziału, w którym wypada percentyl, więc wynik jest z dokładnością do 0.1 ms
+float Profiler::percentile(ProfilePhase phase, float fraction) const {
+    int target = std::max(1, static_cast<int>(fraction * filled + 0.999f));
+    int seen = 0;
+    for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += histogram[phase][bucket];
+        if (seen >= target) {
+            return (bucket + 1) * BUCKET_MS;
+        }
+    }
+    return BUCKETS * BUCKET_MS;
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "SDL.h"
+#include <cstdio>
+#include <string>
+
+//PROFILER_ENABLED=0 usuwa pomiary z kodu: PROFILE_SCOPE znika, a Profiler ma puste metody
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+//fazy klatki mierzone w GameEngine::run; PHASE_FRAME to cała klatka
+enum ProfilePhase {
+    PHASE_INPUT = 0,
+    PHASE_UPDATE,
+    PHASE_TEXT,
+    PHASE_RENDER,
+    PHASE_FLUSH,
+    PHASE_PRESENT,
+    PHASE_FRAME,
+    PHASE_COUNT
+};
+
+struct PhaseStats {
+    float lastMs;
+    float p50Ms;
+    float p99Ms;
+    float maxMs;
+};
+
+#if PROFILER_ENABLED
+
+//czasy faz z ostatnich HISTORY klatek: pierścień wartości do wykresu i histogram po 0.1 ms,
+//z którego percentyle liczy się bez sortowania; klatka wypadająca z okna jest odejmowana z histogramu
+class Profiler {
+public:
+    static constexpr int HISTORY = 240;
+    static constexpr int BUCKETS = 500; // ostatni przedział zbiera wszystko od 49.9 ms
+
+    Profiler();
+    ~Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    bool openCsv(const std::string& filename); // od teraz każda klatka to wiersz z czasami faz w ms
+
+    void beginFrame();
+    void endFrame();
+    void add(ProfilePhase phase, Uint64 ticks) {
+        current[phase] += ticks;
+    }
+
+    PhaseStats getStats(ProfilePhase phase) const;
+    float getFrameMs(int age) const; // 0 = ostatnia zakończona klatka
+    int getFrameCount() const;       // klatki w oknie, najwyżej HISTORY
+
+    static const char* getPhaseName(ProfilePhase phase);
+
+private:
+    float percentile(ProfilePhase phase, float fraction) const;
+
+    double msPerTick;
+    Uint64 frameStart;
+    Uint64 current[PHASE_COUNT];
+    float history[PHASE_COUNT][HISTORY];
+    Uint16 histogram[PHASE_COUNT][BUCKETS];
+    int next;
+    int filled;
+    Uint64 frameIndex;
+    FILE* csv;
+};
+
+//mierzy czas od konstrukcji do końca zakresu i dolicza go do fazy
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, ProfilePhase phase)
+        : profiler(profiler), phase(phase), start(SDL_GetPerformanceCounter()) {
+    }
+    ~ProfileScope() {
+        profiler.add(phase, SDL_GetPerformanceCounter() - start);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler& profiler;
+    ProfilePhase phase;
+    Uint64 start;
+};
+
+#define PROFILE_SCOPE_NAME(line) profileScope##line
+#define PROFILE_SCOPE_AT(profiler, phase, line) ProfileScope PROFILE_SCOPE_NAME(line)(profiler, phase)
+#define PROFILE_SCOPE(profiler, phase) PROFILE_SCOPE_AT(profiler, phase, __LINE__)
+
+#else
+
+class Profiler {
+public:
+    bool openCsv(const std::string&) { return false; }
+    void beginFrame() {}
+    void endFrame() {}
+    void add(ProfilePhase, Uint64) {}
+    PhaseStats getStats(ProfilePhase) const { return PhaseStats(); }
+    float getFrameMs(int) const { return 0.0f; }
+    int getFrameCount() const { return 0; }
+    static const char* getPhaseName(ProfilePhase) { return ""; }
+};
+
+#define PROFILE_SCOPE(profiler, phase) ((void)0)
+
+#endif
+
+#endif
+#pragma once
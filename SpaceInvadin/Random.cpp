@@ -0,0 +1,35 @@
+#include "Random.h"
+
+Random::Random(Uint64 seedValue)
+    : initialSeed(0), state(0) {
+    seed(seedValue);
+}
+//rozprasza seed przez splitmix64, żeby podobne seedy dawały różne ciągi
+void Random::seed(Uint64 seedValue) {
+    initialSeed = seedValue;
+    Uint64 z = seedValue + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    state = z ^ (z >> 31);
+    if (state == 0) {
+        state = 0x9E3779B97F4A7C15ULL; // xorshift nie może mieć stanu 0
+    }
+}
+
+Uint64 Random::getSeed() const {
+    return initialSeed;
+}
+
+Uint32 Random::next() {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return static_cast<Uint32>((state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+int Random::nextInt(int bound) {
+    if (bound <= 0) {
+        return 0;
+    }
+    return static_cast<int>((static_cast<Uint64>(next()) * static_cast<Uint64>(bound)) >> 32);
+}
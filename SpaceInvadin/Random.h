@@ -0,0 +1,23 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include "SDL.h"
+
+//generator liczb losowych należący do silnika (xorshift64*), ten sam seed daje tę samą grę
+class Random {
+public:
+    explicit Random(Uint64 seedValue = 1);
+
+    void seed(Uint64 seedValue);
+    Uint64 getSeed() const;
+
+    Uint32 next();
+    int nextInt(int bound); // liczba z przedziału [0, bound)
+
+private:
+    Uint64 initialSeed;
+    Uint64 state;
+};
+
+#endif
+#pragma once
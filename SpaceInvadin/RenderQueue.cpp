@@ -0,0 +1,100 @@
+#include "RenderQueue.h"
+#include <algorithm>
+
+Uint32 RenderQueue::packColor(const SDL_Color& color) {
+    return (static_cast<Uint32>(color.r) << 24) | (static_cast<Uint32>(color.g) << 16) |
+        (static_cast<Uint32>(color.b) << 8) | static_cast<Uint32>(color.a);
+}
+
+bool RenderQueue::sameState(const Command& a, const Command& b) {
+    return a.layer == b.layer && a.geometry == b.geometry && a.texture == b.texture && a.color == b.color;
+}
+//dopisuje prostokąt, kolejne prostokąty w tym samym kolorze trafiają do jednej komendy
+void RenderQueue::fillRect(const SDL_Rect& rect, const SDL_Color& color, int layer) {
+    Uint32 packed = packColor(color);
+    rects.push_back(rect);
+
+    if (!commands.empty()) {
+        Command& last = commands.back();
+        if (!last.geometry && last.layer == layer && last.color == packed &&
+            last.first + last.count == static_cast<int>(rects.size()) - 1) {
+            last.count++;
+            return;
+        }
+    }
+
+    Command command = { layer, false, 0, packed, static_cast<int>(commands.size()),
+        static_cast<int>(rects.size()) - 1, 1, 0, 0 };
+    commands.push_back(command);
+}
+//dopisuje siatkę trójkątów z teksturą, indeksy są względne do podanych wierzchołków
+void RenderQueue::drawGeometry(TextureId texture, const SDL_Vertex* vertexData, int vertexCount,
+    const int* indexData, int indexCount, int layer) {
+    if (vertexCount <= 0 || indexCount <= 0) {
+        return;
+    }
+
+    Command command = { layer, true, texture, 0, static_cast<int>(commands.size()),
+        static_cast<int>(vertices.size()), vertexCount,
+        static_cast<int>(indices.size()), indexCount };
+    commands.push_back(command);
+
+    vertices.insert(vertices.end(), vertexData, vertexData + vertexCount);
+    indices.insert(indices.end(), indexData, indexData + indexCount);
+}
+//sortuje komendy po warstwie i stanie, potem rysuje każdą grupę jednym wywołaniem
+void RenderQueue::flush(Renderer& renderer) {
+    std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.geometry != b.geometry) return !a.geometry;
+        if (a.texture != b.texture) return a.texture < b.texture;
+        if (a.color != b.color) return a.color < b.color;
+        return a.sequence < b.sequence;
+    });
+
+    size_t i = 0;
+    while (i < commands.size()) {
+        size_t end = i + 1;
+        while (end < commands.size() && sameState(commands[i], commands[end])) {
+            end++;
+        }
+
+        const Command& state = commands[i];
+        if (!state.geometry) {
+            rectBatch.clear();
+            for (size_t c = i; c < end; ++c) {
+                rectBatch.insert(rectBatch.end(), rects.begin() + commands[c].first,
+                    rects.begin() + commands[c].first + commands[c].count);
+            }
+            SDL_Color color = { static_cast<Uint8>(state.color >> 24), static_cast<Uint8>(state.color >> 16),
+                static_cast<Uint8>(state.color >> 8), static_cast<Uint8>(state.color) };
+            renderer.fillRects(color, rectBatch.data(), static_cast<int>(rectBatch.size()));
+        }
+        else {
+            vertexBatch.clear();
+            indexBatch.clear();
+            for (size_t c = i; c < end; ++c) {
+                const Command& command = commands[c];
+                int base = static_cast<int>(vertexBatch.size());
+                vertexBatch.insert(vertexBatch.end(), vertices.begin() + command.first,
+                    vertices.begin() + command.first + command.count);
+                for (int k = 0; k < command.indexCount; ++k) {
+                    indexBatch.push_back(base + indices[command.firstIndex + k]);
+                }
+            }
+            renderer.drawGeometry(state.texture, vertexBatch.data(), static_cast<int>(vertexBatch.size()),
+                indexBatch.data(), static_cast<int>(indexBatch.size()));
+        }
+
+        i = end;
+    }
+
+    clear();
+}
+
+void RenderQueue::clear() {
+    commands.clear();
+    rects.clear();
+    vertices.clear();
+    indices.clear();
+}
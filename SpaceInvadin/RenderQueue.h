@@ -0,0 +1,52 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include "SDL.h"
+#include "Renderer.h"
+#include <vector>
+
+//bufor komend rysowania: encje dopisują prostokąty i geometrię,
+//a flush sortuje je po stanie rysowania i wysyła po jednym wywołaniu na materiał
+class RenderQueue {
+public:
+    enum Layer {
+        LAYER_WORLD = 0,
+        LAYER_PANEL = 1, // tła pod napisami HUD, np. nakładka profilera
+        LAYER_HUD = 2
+    };
+
+    void fillRect(const SDL_Rect& rect, const SDL_Color& color, int layer = LAYER_WORLD);
+    void drawGeometry(TextureId texture, const SDL_Vertex* vertices, int vertexCount,
+        const int* indices, int indexCount, int layer = LAYER_HUD);
+
+    void flush(Renderer& renderer);
+    void clear();
+
+private:
+    struct Command {
+        int layer;
+        bool geometry;
+        TextureId texture;
+        Uint32 color;
+        int sequence;
+        int first;
+        int count;
+        int firstIndex;
+        int indexCount;
+    };
+
+    static Uint32 packColor(const SDL_Color& color);
+    static bool sameState(const Command& a, const Command& b);
+
+    std::vector<Command> commands;
+    std::vector<SDL_Rect> rects;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    std::vector<SDL_Rect> rectBatch;
+    std::vector<SDL_Vertex> vertexBatch;
+    std::vector<int> indexBatch;
+};
+
+#endif
+#pragma once
@@ -0,0 +1,50 @@
+#include "Renderer.h"
+
+Renderer::Renderer()
+    : stats{ 0, 0, 0, 0, 0 } {
+}
+//publiczne metody zliczają statystyki, a rysowanie zlecają backendowi
+TextureId Renderer::createTexture(SDL_Surface* surface) {
+    TextureId texture = doCreateTexture(surface);
+    if (texture != 0) {
+        stats.textures++;
+    }
+    return texture;
+}
+
+void Renderer::destroyTexture(TextureId texture) {
+    if (texture != 0) {
+        doDestroyTexture(texture);
+    }
+}
+
+void Renderer::clear(const SDL_Color& color) {
+    doClear(color);
+}
+
+void Renderer::fillRects(const SDL_Color& color, const SDL_Rect* rects, int count) {
+    if (count <= 0) {
+        return;
+    }
+    stats.drawCalls++;
+    stats.rects += count;
+    doFillRects(color, rects, count);
+}
+
+void Renderer::drawGeometry(TextureId texture, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount) {
+    if (vertexCount <= 0 || indexCount <= 0) {
+        return;
+    }
+    stats.drawCalls++;
+    stats.vertices += vertexCount;
+    doDrawGeometry(texture, vertices, vertexCount, indices, indexCount);
+}
+
+void Renderer::present() {
+    stats.frames++;
+    doPresent();
+}
+
+const RenderStats& Renderer::getStats() const {
+    return stats;
+}
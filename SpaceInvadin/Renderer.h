@@ -0,0 +1,48 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include "SDL.h"
+
+typedef int TextureId; // 0 oznacza brak tekstury
+
+struct RenderStats {
+    long long frames;
+    long long drawCalls;
+    long long rects;
+    long long vertices;
+    long long textures;
+};
+
+//interfejs backendu rysującego, gra nie odwołuje się bezpośrednio do SDL_Renderer
+class Renderer {
+public:
+    Renderer();
+    virtual ~Renderer() {}
+
+    virtual bool initialize(const char* title, int width, int height) = 0;
+    virtual void shutdown() = 0;
+
+    TextureId createTexture(SDL_Surface* surface);
+    void destroyTexture(TextureId texture);
+
+    void clear(const SDL_Color& color);
+    void fillRects(const SDL_Color& color, const SDL_Rect* rects, int count);
+    void drawGeometry(TextureId texture, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount);
+    void present();
+
+    const RenderStats& getStats() const;
+
+protected:
+    virtual TextureId doCreateTexture(SDL_Surface* surface) = 0;
+    virtual void doDestroyTexture(TextureId texture) = 0;
+    virtual void doClear(const SDL_Color& color) = 0;
+    virtual void doFillRects(const SDL_Color& color, const SDL_Rect* rects, int count) = 0;
+    virtual void doDrawGeometry(TextureId texture, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount) = 0;
+    virtual void doPresent() = 0;
+
+private:
+    RenderStats stats;
+};
+
+#endif
+#pragma once
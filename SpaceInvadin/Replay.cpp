@@ -0,0 +1,200 @@
+#include "Replay.h"
+#include <cstring>
+#include <iterator>
+
+namespace {
+    const char REPLAY_MAGIC[4] = { 'S', 'I', 'R', 'P' };
+    const Uint16 REPLAY_VERSION = 1;
+    const int MAX_TICK_RATE = 0xFFFF; // nagłówek trzyma częstotliwość na 2 bajtach
+
+    void writeLittleEndian(std::ofstream& file, Uint64 value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void writeVarint(std::ofstream& file, Uint32 value) {
+        while (value >= 0x80) {
+            file.put(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        file.put(static_cast<char>(value));
+    }
+}
+
+ReplayWriter::ReplayWriter()
+    : runButtons(0), runLength(0), tickCount(0) {
+}
+
+ReplayWriter::~ReplayWriter() {
+    close();
+}
+//zapisuje nagłówek nagrania, stan startowy to zawartość zapisu gry
+bool ReplayWriter::open(const std::string& filename, Uint64 seed, int tickRate, const std::string& initialState) {
+    if (tickRate <= 0 || tickRate > MAX_TICK_RATE) {
+        SDL_Log("Tick rate %d does not fit in the replay header of %s", tickRate, filename.c_str());
+        return false;
+    }
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        SDL_Log("Failed to open replay file: %s", filename.c_str());
+        return false;
+    }
+
+    file.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    writeLittleEndian(file, REPLAY_VERSION, 2);
+    writeLittleEndian(file, static_cast<Uint64>(tickRate), 2);
+    writeLittleEndian(file, seed, 8);
+    writeLittleEndian(file, initialState.size(), 4);
+    file.write(initialState.data(), initialState.size());
+
+    runButtons = 0;
+    runLength = 0;
+    tickCount = 0;
+    return true;
+}
+
+void ReplayWriter::write(const InputFrame& input) {
+    if (!file.is_open()) {
+        return;
+    }
+    if (runLength > 0 && input.buttons != runButtons) {
+        flushRun();
+    }
+    runButtons = input.buttons;
+    runLength++;
+    tickCount++;
+}
+
+void ReplayWriter::flushRun() {
+    if (runLength > 0) {
+        file.put(static_cast<char>(runButtons));
+        writeVarint(file, runLength);
+        runLength = 0;
+    }
+}
+
+void ReplayWriter::close() {
+    if (file.is_open()) {
+        flushRun();
+        file.close();
+        SDL_Log("Replay recorded: %u ticks", tickCount);
+    }
+}
+
+bool ReplayWriter::isOpen() const {
+    return file.is_open();
+}
+
+ReplayReader::ReplayReader()
+    : position(0), opened(false), seed(0), tickRate(0), runButtons(0), runRemaining(0), tick(0) {
+}
+//wczytuje całe nagranie do pamięci i sprawdza nagłówek
+bool ReplayReader::open(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        SDL_Log("Failed to open replay file: %s", filename.c_str());
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    position = 0;
+
+    const size_t headerSize = 4 + 2 + 2 + 8 + 4;
+    if (data.size() < headerSize || std::memcmp(data.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0) {
+        SDL_Log("Not a replay file: %s", filename.c_str());
+        return false;
+    }
+
+    auto readLittleEndian = [this](int bytes) {
+        Uint64 value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<Uint64>(data[position++]) << (8 * i);
+        }
+        return value;
+    };
+
+    position = sizeof(REPLAY_MAGIC);
+    Uint64 version = readLittleEndian(2);
+    if (version != REPLAY_VERSION) {
+        SDL_Log("Unsupported replay version %u in %s", static_cast<unsigned>(version), filename.c_str());
+        return false;
+    }
+    tickRate = static_cast<int>(readLittleEndian(2));
+    if (tickRate <= 0) {
+        SDL_Log("Invalid replay tick rate %d in %s", tickRate, filename.c_str());
+        return false;
+    }
+    seed = readLittleEndian(8);
+    Uint64 stateLength = readLittleEndian(4);
+    if (stateLength > data.size() - position) {
+        SDL_Log("Truncated replay file: %s", filename.c_str());
+        return false;
+    }
+    initialState.assign(reinterpret_cast<const char*>(data.data()) + position, static_cast<size_t>(stateLength));
+    position += static_cast<size_t>(stateLength);
+
+    runButtons = 0;
+    runRemaining = 0;
+    tick = 0;
+    opened = true;
+    return true;
+}
+//zwraca wejście następnego ticka, false gdy nagranie się skończyło
+bool ReplayReader::read(InputFrame* input) {
+    if (!opened) {
+        return false;
+    }
+    if (runRemaining == 0) {
+        if (!readByte(&runButtons) || !readVarint(&runRemaining) || runRemaining == 0) {
+            return false;
+        }
+    }
+    input->buttons = runButtons;
+    runRemaining--;
+    tick++;
+    return true;
+}
+
+bool ReplayReader::readByte(Uint8* value) {
+    if (position >= data.size()) {
+        return false;
+    }
+    *value = data[position++];
+    return true;
+}
+
+bool ReplayReader::readVarint(Uint32* value) {
+    Uint32 result = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        Uint8 byte;
+        if (!readByte(&byte)) {
+            return false;
+        }
+        result |= static_cast<Uint32>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ReplayReader::isOpen() const {
+    return opened;
+}
+
+Uint64 ReplayReader::getSeed() const {
+    return seed;
+}
+
+int ReplayReader::getTickRate() const {
+    return tickRate;
+}
+
+const std::string& ReplayReader::getInitialState() const {
+    return initialState;
+}
+
+Uint32 ReplayReader::getTick() const {
+    return tick;
+}
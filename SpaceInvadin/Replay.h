@@ -0,0 +1,59 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "InputFrame.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+//plik nagrania: nagłówek (seed, tick rate, stan startowy) i wejście z każdego ticka
+//zapisane jako serie (przyciski, liczba ticków), więc trzymanie klawisza kosztuje 2-3 bajty
+class ReplayWriter {
+public:
+    ReplayWriter();
+    ~ReplayWriter();
+
+    bool open(const std::string& filename, Uint64 seed, int tickRate, const std::string& initialState);
+    void write(const InputFrame& input);
+    void close();
+    bool isOpen() const;
+
+private:
+    void flushRun();
+
+    std::ofstream file;
+    Uint8 runButtons;
+    Uint32 runLength;
+    Uint32 tickCount;
+};
+
+class ReplayReader {
+public:
+    ReplayReader();
+
+    bool open(const std::string& filename);
+    bool read(InputFrame* input);
+    bool isOpen() const;
+
+    Uint64 getSeed() const;
+    int getTickRate() const;
+    const std::string& getInitialState() const;
+    Uint32 getTick() const;
+
+private:
+    bool readByte(Uint8* value);
+    bool readVarint(Uint32* value);
+
+    std::vector<Uint8> data;
+    size_t position;
+    bool opened;
+    Uint64 seed;
+    int tickRate;
+    std::string initialState;
+    Uint8 runButtons;
+    Uint32 runRemaining;
+    Uint32 tick;
+};
+
+#endif
+#pragma once
@@ -0,0 +1,153 @@
+#include "SaveGame.h"
+#include "AtomicFile.h"
+#include "Crc32.h"
+#include "MappedFile.h"
+#include <cstring>
+
+namespace {
+    const char SAVE_MAGIC[4] = { 'S', 'I', 'S', 'V' };
+    const Uint16 SAVE_VERSION = 1;
+    const size_t HEADER_SIZE = 4 + 2 + 2 + 4 + 4;
+    const size_t FIXED_FIELDS_SIZE = 6 * 4 + 4; // gracz, poziom, prędkość, kierunek, liczba obcych
+
+    void putLittleEndian(std::vector<Uint8>& out, Uint32 value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<Uint8>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void patchLittleEndian(std::vector<Uint8>& out, size_t offset, Uint32 value) {
+        for (int i = 0; i < 4; ++i) {
+            out[offset + i] = static_cast<Uint8>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    Uint32 getLittleEndian(const Uint8* data, int bytes) {
+        Uint32 value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<Uint32>(data[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    Sint32 getInt(const Uint8*& cursor) {
+        Sint32 value = static_cast<Sint32>(getLittleEndian(cursor, 4));
+        cursor += 4;
+        return value;
+    }
+}
+
+void encodeSave(const Simulation& sim, std::vector<Uint8>* out) {
+    int alienCount = sim.aliens.size();
+    out->clear();
+    out->reserve(HEADER_SIZE + FIXED_FIELDS_SIZE + alienCount * 8 + (alienCount + 7) / 8);
+
+    out->insert(out->end(), SAVE_MAGIC, SAVE_MAGIC + sizeof(SAVE_MAGIC));
+    putLittleEndian(*out, SAVE_VERSION, 2);
+    putLittleEndian(*out, static_cast<Uint32>(HEADER_SIZE), 2);
+    putLittleEndian(*out, 0, 4); // rozmiar i CRC uzupełniane po zapisaniu danych
+    putLittleEndian(*out, 0, 4);
+
+    putLittleEndian(*out, static_cast<Uint32>(sim.player.x), 4);
+    putLittleEndian(*out, static_cast<Uint32>(sim.player.y), 4);
+    putLittleEndian(*out, static_cast<Uint32>(sim.playerHealth), 4);
+    putLittleEndian(*out, static_cast<Uint32>(sim.level), 4);
+    putLittleEndian(*out, static_cast<Uint32>(sim.alienSpeed), 4);
+    putLittleEndian(*out, static_cast<Uint32>(sim.alienDirection), 4);
+    putLittleEndian(*out, static_cast<Uint32>(alienCount), 4);
+    for (int i = 0; i < alienCount; ++i) {
+        putLittleEndian(*out, static_cast<Uint32>(sim.aliens.getX(i)), 4);
+    }
+    for (int i = 0; i < alienCount; ++i) {
+        putLittleEndian(*out, static_cast<Uint32>(sim.aliens.getY(i)), 4);
+    }
+    size_t maskStart = out->size();
+    out->resize(maskStart + (alienCount + 7) / 8, 0);
+    for (int i = 0; i < alienCount; ++i) {
+        if (sim.aliens.isAlive(i)) {
+            (*out)[maskStart + i / 8] |= static_cast<Uint8>(1 << (i % 8));
+        }
+    }
+
+    size_t payloadSize = out->size() - HEADER_SIZE;
+    patchLittleEndian(*out, 8, static_cast<Uint32>(payloadSize));
+    patchLittleEndian(*out, 12, crc32(out->data() + HEADER_SIZE, payloadSize));
+}
+//najpierw sprawdza nagłówek, CRC i spójność rozmiarów, dopiero poprawne dane trafiają do symulacji
+bool decodeSave(const Uint8* data, size_t size, Simulation* sim) {
+    if (size < HEADER_SIZE || std::memcmp(data, SAVE_MAGIC, sizeof(SAVE_MAGIC)) != 0) {
+        SDL_Log("Not a save file");
+        return false;
+    }
+    Uint32 version = getLittleEndian(data + 4, 2);
+    Uint32 headerSize = getLittleEndian(data + 6, 2);
+    Uint32 payloadSize = getLittleEndian(data + 8, 4);
+    Uint32 storedCrc = getLittleEndian(data + 12, 4);
+    if (version != SAVE_VERSION || headerSize != HEADER_SIZE) {
+        SDL_Log("Unsupported save version %u", version);
+        return false;
+    }
+    if (payloadSize != size - HEADER_SIZE || payloadSize < FIXED_FIELDS_SIZE) {
+        SDL_Log("Save file is truncated (%u of %u bytes)", static_cast<unsigned>(size - HEADER_SIZE), payloadSize);
+        return false;
+    }
+    const Uint8* payload = data + HEADER_SIZE;
+    if (crc32(payload, payloadSize) != storedCrc) {
+        SDL_Log("Save file checksum mismatch");
+        return false;
+    }
+
+    const Uint8* cursor = payload;
+    Sint32 playerX = getInt(cursor);
+    Sint32 playerY = getInt(cursor);
+    Sint32 playerHealth = getInt(cursor);
+    Sint32 level = getInt(cursor);
+    Sint32 alienSpeed = getInt(cursor);
+    Sint32 alienDirection = getInt(cursor);
+    Uint32 alienCount = getLittleEndian(cursor, 4);
+    cursor += 4;
+
+    Uint64 expected = FIXED_FIELDS_SIZE + static_cast<Uint64>(alienCount) * 8 + (static_cast<Uint64>(alienCount) + 7) / 8;
+    if (expected != payloadSize || level < 1 || (alienDirection != 1 && alienDirection != -1)) {
+        SDL_Log("Save file contents are inconsistent");
+        return false;
+    }
+
+    sim->player.x = playerX;
+    sim->player.y = playerY;
+    sim->playerHealth = playerHealth;
+    sim->level = level;
+    sim->alienSpeed = alienSpeed;
+    sim->alienDirection = alienDirection;
+
+    const Uint8* xs = cursor;
+    const Uint8* ys = xs + alienCount * 4;
+    const Uint8* mask = ys + alienCount * 4;
+    sim->aliens.clear();
+    sim->aliens.reserve(static_cast<int>(alienCount));
+    for (Uint32 i = 0; i < alienCount; ++i) {
+        int index = sim->aliens.add(static_cast<Sint32>(getLittleEndian(xs + i * 4, 4)),
+            static_cast<Sint32>(getLittleEndian(ys + i * 4, 4)));
+        sim->aliens.setAlive(index, (mask[i / 8] >> (i % 8)) & 1);
+    }
+    return true;
+}
+
+bool writeSaveFile(const std::string& filename, const Simulation& sim) {
+    std::vector<Uint8> bytes;
+    encodeSave(sim, &bytes);
+    return writeFileAtomic(filename, bytes.data(), bytes.size());
+}
+
+bool readSaveFile(const std::string& filename, Simulation* sim) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        SDL_Log("Failed to open save file: %s", filename.c_str());
+        return false;
+    }
+    if (!decodeSave(file.getData(), file.getSize(), sim)) {
+        SDL_Log("Rejected save file: %s", filename.c_str());
+        return false;
+    }
+    return true;
+}
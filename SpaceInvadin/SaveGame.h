@@ -0,0 +1,18 @@
+#ifndef SAVE_GAME_H
+#define SAVE_GAME_H
+
+#include "Simulation.h"
+#include <string>
+#include <vector>
+
+//binarny zapis gry: nagłówek (magia, wersja, rozmiar i CRC-32 danych), potem pola o stałej szerokości
+//little-endian, pozycje obcych jako dwie tablice x/y i maska życia po 8 obcych na bajt
+//tekstowy Simulation::writeState/readState zostaje jako eksport i import
+void encodeSave(const Simulation& sim, std::vector<Uint8>* out);
+bool decodeSave(const Uint8* data, size_t size, Simulation* sim); // uszkodzony zapis nie zmienia sim
+
+bool writeSaveFile(const std::string& filename, const Simulation& sim); // synchronicznie, przez writeFileAtomic
+bool readSaveFile(const std::string& filename, Simulation* sim);
+
+#endif
+#pragma once
@@ -0,0 +1,104 @@
+#include "SaveWorker.h"
+#include "AtomicFile.h"
+#include "Trace.h"
+#include <chrono>
+
+SaveWorker::SaveWorker()
+    : stopping(false) {
+    thread = std::thread(&SaveWorker::workerLoop, this);
+}
+
+SaveWorker::~SaveWorker() {
+    shutdown();
+}
+
+SaveHandle SaveWorker::submit(const std::string& filename, std::vector<Uint8> bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // tylko ostatnie zgłoszenie, żeby nowsze bajty nie wyprzedziły dopisków czekających za nim
+        if (!jobs.empty() && jobs.back().kind == JOB_REPLACE && jobs.back().filename == filename) {
+            jobs.back().bytes = std::move(bytes);
+            return jobs.back().handle;
+        }
+    }
+
+    Job job;
+    job.kind = JOB_REPLACE;
+    job.filename = filename;
+    job.bytes = std::move(bytes);
+    return enqueue(std::move(job));
+}
+
+SaveHandle SaveWorker::append(const std::string& filename, std::vector<Uint8> bytes) {
+    Job job;
+    job.kind = JOB_APPEND;
+    job.filename = filename;
+    job.bytes = std::move(bytes);
+    return enqueue(std::move(job));
+}
+
+SaveHandle SaveWorker::run(std::function<bool()> task) {
+    Job job;
+    job.kind = JOB_TASK;
+    job.task = std::move(task);
+    return enqueue(std::move(job));
+}
+
+SaveHandle SaveWorker::enqueue(Job job) {
+    job.promise = std::make_shared<std::promise<bool>>();
+    job.handle = job.promise->get_future().share();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopping) {
+        job.promise->set_value(false); // po shutdown() nikt już nie zapisze
+        return job.handle;
+    }
+    jobs.push_back(std::move(job));
+    wake.notify_one();
+    return jobs.back().handle;
+}
+
+void SaveWorker::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool SaveWorker::isDone(const SaveHandle& handle) {
+    return handle.valid() && handle.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+//zdejmuje zadanie z kolejki przed zapisem, więc nowsze zgłoszenie tego samego pliku idzie jako osobny zapis
+void SaveWorker::workerLoop() {
+    Tracer::instance().setThreadName("save worker");
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return; // stopping i nic do zapisania
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        TRACE_ZONE(job.kind == JOB_REPLACE ? "write file" : job.kind == JOB_APPEND ? "append file" : "save task");
+        bool saved = false;
+        switch (job.kind) {
+        case JOB_REPLACE:
+            saved = writeFileAtomic(job.filename, job.bytes.data(), job.bytes.size());
+            break;
+        case JOB_APPEND:
+            saved = appendFileDurable(job.filename, job.bytes.data(), job.bytes.size());
+            break;
+        case JOB_TASK:
+            saved = job.task();
+            break;
+        }
+        job.promise->set_value(saved);
+    }
+}
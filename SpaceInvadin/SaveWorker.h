@@ -0,0 +1,63 @@
+#ifndef SAVE_WORKER_H
+#define SAVE_WORKER_H
+
+#include "SDL.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//uchwyt zakończenia zapisu: get() czeka i zwraca, czy plik trafił na dysk
+typedef std::shared_future<bool> SaveHandle;
+
+//wątek zapisu plików w tle: wątek gry oddaje gotowe bajty i od razu wraca do pętli,
+//a wątek roboczy wykonuje zgłoszenia (podmiana pliku, dopisanie, dowolne zadanie) w kolejności zgłoszeń
+class SaveWorker {
+public:
+    SaveWorker();
+    ~SaveWorker();
+    SaveWorker(const SaveWorker&) = delete;
+    SaveWorker& operator=(const SaveWorker&) = delete;
+
+    //podmiana pliku przez writeFileAtomic; jeśli ostatnie zgłoszenie w kolejce podmienia ten sam plik,
+    //dostaje nowsze bajty i ten sam uchwyt
+    SaveHandle submit(const std::string& filename, std::vector<Uint8> bytes);
+    SaveHandle append(const std::string& filename, std::vector<Uint8> bytes); // przez appendFileDurable
+    SaveHandle run(std::function<bool()> task);
+    void shutdown(); // dokańcza wszystkie zgłoszone zapisy i zatrzymuje wątek
+
+    static bool isDone(const SaveHandle& handle);
+
+private:
+    enum JobKind {
+        JOB_REPLACE,
+        JOB_APPEND,
+        JOB_TASK
+    };
+
+    struct Job {
+        JobKind kind;
+        std::string filename;
+        std::vector<Uint8> bytes;
+        std::function<bool()> task;
+        std::shared_ptr<std::promise<bool>> promise;
+        SaveHandle handle;
+    };
+
+    SaveHandle enqueue(Job job);
+    void workerLoop();
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Job> jobs;
+    bool stopping;
+    std::thread thread;
+};
+
+#endif
+#pragma once
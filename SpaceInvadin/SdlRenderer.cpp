@@ -0,0 +1,86 @@
+#include "SdlRenderer.h"
+#include <iostream>
+
+SdlRenderer::SdlRenderer()
+    : window(nullptr), renderer(nullptr) {
+}
+
+SdlRenderer::~SdlRenderer() {
+    shutdown();
+}
+//tworzy okno i renderer SDL, wymaga zainicjalizowanego SDL_INIT_VIDEO
+bool SdlRenderer::initialize(const char* title, int width, int height) {
+    window = SDL_CreateWindow(title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, SDL_WINDOW_SHOWN);
+    if (!window) {
+        std::cerr << "Window could not be created! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!renderer) {
+        std::cerr << "Renderer could not be created! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void SdlRenderer::shutdown() {
+    for (auto* texture : textures) {
+        if (texture) {
+            SDL_DestroyTexture(texture);
+        }
+    }
+    textures.clear();
+
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+        renderer = nullptr;
+    }
+    if (window) {
+        SDL_DestroyWindow(window);
+        window = nullptr;
+    }
+}
+
+SDL_Texture* SdlRenderer::findTexture(TextureId texture) const {
+    if (texture <= 0 || texture > static_cast<int>(textures.size())) {
+        return nullptr;
+    }
+    return textures[texture - 1];
+}
+
+TextureId SdlRenderer::doCreateTexture(SDL_Surface* surface) {
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture) {
+        return 0;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    textures.push_back(texture);
+    return static_cast<TextureId>(textures.size());
+}
+
+void SdlRenderer::doDestroyTexture(TextureId texture) {
+    SDL_Texture* sdlTexture = findTexture(texture);
+    if (sdlTexture) {
+        SDL_DestroyTexture(sdlTexture);
+        textures[texture - 1] = nullptr;
+    }
+}
+
+void SdlRenderer::doClear(const SDL_Color& color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderClear(renderer);
+}
+
+void SdlRenderer::doFillRects(const SDL_Color& color, const SDL_Rect* rects, int count) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRects(renderer, rects, count);
+}
+
+void SdlRenderer::doDrawGeometry(TextureId texture, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount) {
+    SDL_RenderGeometry(renderer, findTexture(texture), vertices, vertexCount, indices, indexCount);
+}
+
+void SdlRenderer::doPresent() {
+    SDL_RenderPresent(renderer);
+}
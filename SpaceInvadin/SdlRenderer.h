@@ -0,0 +1,33 @@
+#ifndef SDL_RENDERER_BACKEND_H
+#define SDL_RENDERER_BACKEND_H
+
+#include "Renderer.h"
+#include <vector>
+
+//backend rysujący przez okno i SDL_Renderer
+class SdlRenderer : public Renderer {
+public:
+    SdlRenderer();
+    ~SdlRenderer();
+
+    bool initialize(const char* title, int width, int height) override;
+    void shutdown() override;
+
+protected:
+    TextureId doCreateTexture(SDL_Surface* surface) override;
+    void doDestroyTexture(TextureId texture) override;
+    void doClear(const SDL_Color& color) override;
+    void doFillRects(const SDL_Color& color, const SDL_Rect* rects, int count) override;
+    void doDrawGeometry(TextureId texture, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount) override;
+    void doPresent() override;
+
+private:
+    SDL_Texture* findTexture(TextureId texture) const;
+
+    SDL_Window* window;
+    SDL_Renderer* renderer;
+    std::vector<SDL_Texture*> textures;
+};
+
+#endif
+#pragma once
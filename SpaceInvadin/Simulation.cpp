@@ -0,0 +1,393 @@
+#include "Simulation.h"
+#include "Log.h"
+#include "Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+
+Simulation::Simulation()
+    : player(SCREEN_WIDTH / 2 - 25, SCREEN_HEIGHT - 60, 50, 20, 5),
+    playerHealth(3), level(1), alienSpeed(1), alienDirection(1), score(0),
+    gameOver(false), tickCount(0), tickRate(REFERENCE_TICK_RATE),
+    alienGrid(SCREEN_WIDTH, SCREEN_HEIGHT, GRID_CELL_SIZE),
+    jobs(nullptr), tickJobs(nullptr), hitBuffers(1), playerHitCounts(1) {
+}
+//ustawia nową grę od pierwszego poziomu z podanym seedem
+void Simulation::reset(Uint64 seed) {
+    player = Player(SCREEN_WIDTH / 2 - 25, SCREEN_HEIGHT - 60, 50, 20, 5);
+    playerBullets.clear();
+    alienBullets.clear();
+    playerHealth = 3;
+    level = 1;
+    alienDirection = 1;
+    score = 0;
+    gameOver = false;
+    tickCount = 0;
+    rng.seed(seed);
+    resetAliens();
+}
+
+//sprawdza obecny stan przeciwników
+void Simulation::analyzeAliens(int* activeCount, int* totalCount, int* speed) {
+    *activeCount = aliens.aliveCount();
+    *totalCount = aliens.size();
+
+    *speed = difficulty.baseAlienSpeed + (level / 2);
+}
+//część ruchu o perReferenceTick na tick przy REFERENCE_TICK_RATE, która przypada na bieżący tick przy tickRate;
+//liczona z licznika ticków, więc zaokrąglenia się nie sumują i po sekundzie droga jest ta sama przy każdej częstotliwości
+int Simulation::stepFor(int perReferenceTick) const {
+    Sint64 scaled = static_cast<Sint64>(perReferenceTick) * REFERENCE_TICK_RATE;
+    Sint64 tick = tickCount;
+    return static_cast<int>(scaled * tick / tickRate - scaled * (tick - 1) / tickRate);
+}
+//nadpisuje stan gry w każdej klatce (ruch przeciwników pocisków i gracza)
+//sprawdza kolizje,strzały obcych,progres poziomu i warunki game overu
+void Simulation::update(const InputFrame& input) {
+    TRACE_ZONE("sim tick");
+    tickCount++;
+
+    if (input.has(INPUT_LEFT)) {
+        player.moveLeft(stepFor(player.speed));
+    }
+    if (input.has(INPUT_RIGHT)) {
+        player.moveRight(stepFor(player.speed));
+    }
+    if (input.has(INPUT_FIRE)) {
+        playerBullets.spawn(player.x + player.w / 2 - 5, player.y - 10, 5, 10);
+    }
+
+    int activeAliens = 0;
+    int totalAliens = 0;
+    int currentSpeed = 0;
+
+    analyzeAliens(&activeAliens, &totalAliens, &currentSpeed);
+    
+    alienSpeed = currentSpeed;
+
+    LOG_DEBUG(LOG_SIM, "Active aliens: %d, total aliens: %d, alien speed: %d", activeAliens, totalAliens, currentSpeed);
+
+    // niezależne kroki idą naraz: pociski gracza, pociski obcych i formacja nie dzielą danych; strzał obcych czeka
+    // na formację i pociski obcych, kolizje pocisków gracza na strzał obcych (czyta bity życia, które one zmieniają),
+    // a trafienia gracza na strzał obcych; wynik jest taki sam jak przy kolejności szeregowej
+    tickJobs = (jobs && jobs->getThreadCount() > 1 &&
+        aliens.size() + playerBullets.size() + alienBullets.size() >= PARALLEL_MIN_ENTITIES) ? jobs : nullptr;
+    if (tickJobs) {
+        JobGraph graph;
+        int movePlayer = graph.add([this](int) { movePlayerBullets(); });
+        int moveAlien = graph.add([this](int) { moveAlienBullets(); });
+        int moveFormation = graph.add([this](int) { moveAliens(); });
+        int fire = graph.add([this](int) {
+            TRACE_ZONE("alien fire");
+            alienFire(stepFor(1));
+        });
+        int collidePlayer = graph.add([this](int) { collidePlayerBullets(); });
+        int collideAlien = graph.add([this](int) { collideAlienBullets(); });
+        graph.depend(fire, moveAlien);
+        graph.depend(fire, moveFormation);
+        graph.depend(collidePlayer, movePlayer);
+        graph.depend(collidePlayer, fire);
+        graph.depend(collideAlien, fire);
+        tickJobs->run(graph);
+    }
+    else {
+        movePlayerBullets();
+        moveAlienBullets();
+        moveAliens();
+        {
+            TRACE_ZONE("alien fire");
+            alienFire(stepFor(1));
+        }
+        collidePlayerBullets();
+        collideAlienBullets();
+    }
+
+    if (aliens.aliveCount() == 0) {
+        level++;
+        alienSpeed++;
+        resetAliens();
+    }
+}
+
+void Simulation::setJobSystem(JobSystem* jobSystem) {
+    jobs = jobSystem;
+    int workers = jobs ? jobs->getThreadCount() : 1;
+    hitBuffers.resize(workers);
+    playerHitCounts.resize(workers);
+}
+//w ticku równoległym dzieli zakres między wątki, inaczej liczy go w całości na bieżącym
+void Simulation::forRange(int count, int grain, const JobSystem::RangeWork& work) {
+    if (tickJobs) {
+        tickJobs->parallelFor(count, grain, work);
+    }
+    else if (count > 0) {
+        work(0, count, 0);
+    }
+}
+
+void Simulation::movePlayerBullets() {
+    TRACE_ZONE("bullet move");
+    // pociski gracza lecą w górę i gasną nad ekranem
+    int dy = stepFor(-10);
+    forRange(playerBullets.size(), BULLET_GRAIN, [this, dy](int begin, int end, int) {
+        playerBullets.advance(dy, 0, std::numeric_limits<int>::max(), begin, end);
+    });
+    playerBullets.compact();
+}
+
+void Simulation::moveAlienBullets() {
+    TRACE_ZONE("bullet move");
+    // pociski obcych lecą w dół i gasną pod ekranem
+    int dy = stepFor(4);
+    forRange(alienBullets.size(), BULLET_GRAIN, [this, dy](int begin, int end, int) {
+        alienBullets.advance(dy, std::numeric_limits<int>::min(), SCREEN_HEIGHT, begin, end);
+    });
+    alienBullets.compact();
+}
+//krawędź i dojście do gracza to OR po zakresach, więc podział nie zmienia wyniku
+void Simulation::moveAliens() {
+    TRACE_ZONE("alien move");
+    int dx = alienDirection * stepFor(alienSpeed);
+    if (dx == 0) {
+        return; // tick bez ruchu przy wysokiej częstotliwości; formacja przy krawędzi odbiłaby się drugi raz
+    }
+    std::atomic<bool> changeDirection(false);
+    forRange(aliens.size(), ALIEN_GRAIN, [this, dx, &changeDirection](int begin, int end, int) {
+        if (aliens.moveAndCheckEdges(dx, 0, SCREEN_WIDTH, begin, end)) {
+            changeDirection.store(true, std::memory_order_relaxed);
+        }
+    });
+
+    if (changeDirection.load()) {
+        alienDirection *= -1;
+        SDL_Rect playerRect = { player.x, player.y, player.w, player.h };
+        std::atomic<bool> reached(false);
+        forRange(aliens.size(), ALIEN_GRAIN, [this, &playerRect, &reached](int begin, int end, int) {
+            if (aliens.dropAndCheckReach(10, playerRect, begin, end)) {
+                reached.store(true, std::memory_order_relaxed);
+            }
+        });
+        if (reached.load()) {
+            gameOver = true;
+        }
+    }
+}
+//kandydaci są liczeni równolegle względem obcych żywych na początku kroku, każdy wątek do własnego bufora;
+//potem rozstrzyga je jeden wątek w kolejności pocisków, jak pętla szeregowa: jeśli kandydata zestrzelił już
+//wcześniejszy pocisk, pierwszym trafieniem jest kolejny żywy obcy, więc ten pocisk jest sprawdzany jeszcze raz
+void Simulation::collidePlayerBullets() {
+    TRACE_ZONE("collision");
+    // przy dużej liczbie par każdy pocisk sprawdza tylko obcych z komórek siatki, na które nachodzi
+    bool useGrid = static_cast<size_t>(playerBullets.size()) * aliens.size() > GRID_MIN_PAIRS;
+    if (useGrid) {
+        alienGrid.build(aliens);
+    }
+    for (auto& buffer : hitBuffers) {
+        buffer.clear();
+    }
+    const BulletPool& bullets = playerBullets;
+    forRange(playerBullets.size(), COLLISION_GRAIN, [this, &bullets, useGrid](int begin, int end, int worker) {
+        std::vector<BulletHit>& hits = hitBuffers[worker];
+        for (int i = begin; i < end; ++i) {
+            if (!bullets.isActive(i)) {
+                continue;
+            }
+            int x = bullets.getX(i);
+            int y = bullets.getY(i);
+            int w = bullets.getWidth(i);
+            int h = bullets.getHeight(i);
+            int hit = useGrid ? alienGrid.findFirstHit(aliens, x, y, w, h) : aliens.findFirstHit(x, y, w, h);
+            if (hit >= 0) {
+                hits.push_back(BulletHit{ i, hit });
+            }
+        }
+    });
+
+    const std::vector<BulletHit>* ordered = &hitBuffers[0];
+    if (tickJobs) {
+        mergedHits.clear();
+        for (const auto& buffer : hitBuffers) {
+            mergedHits.insert(mergedHits.end(), buffer.begin(), buffer.end());
+        }
+        std::sort(mergedHits.begin(), mergedHits.end(),
+            [](const BulletHit& a, const BulletHit& b) { return a.bullet < b.bullet; });
+        ordered = &mergedHits;
+    }
+    for (const auto& candidate : *ordered) {
+        int bullet = candidate.bullet;
+        int hit = candidate.alien;
+        if (!aliens.isAlive(hit)) {
+            int x = bullets.getX(bullet);
+            int y = bullets.getY(bullet);
+            int w = bullets.getWidth(bullet);
+            int h = bullets.getHeight(bullet);
+            hit = useGrid ? alienGrid.findFirstHit(aliens, x, y, w, h) : aliens.findFirstHit(x, y, w, h);
+            if (hit < 0) {
+                continue;
+            }
+        }
+        playerBullets.deactivate(bullet);
+        aliens.setAlive(hit, false);
+        score += 10;
+    }
+}
+//trafienia zależą tylko od prostokąta gracza, więc liczy się je niezależnie i odejmuje sumę; życie tylko maleje,
+//więc game over wychodzi ten sam co przy odejmowaniu po jednym
+void Simulation::collideAlienBullets() {
+    TRACE_ZONE("collision");
+    std::fill(playerHitCounts.begin(), playerHitCounts.end(), 0);
+    BulletPool& bullets = alienBullets;
+    SDL_Rect playerRect = { player.x, player.y, player.w, player.h };
+    forRange(alienBullets.size(), BULLET_GRAIN, [this, &bullets, &playerRect](int begin, int end, int worker) {
+        int hits = 0;
+        for (int i = begin; i < end; ++i) {
+            int x = bullets.getX(i);
+            int y = bullets.getY(i);
+            if (bullets.isActive(i) && x < playerRect.x + playerRect.w && x + bullets.getWidth(i) > playerRect.x &&
+                y < playerRect.y + playerRect.h && y + bullets.getHeight(i) > playerRect.y) {
+                bullets.deactivate(i);
+                hits++;
+            }
+        }
+        playerHitCounts[worker] += hits;
+    });
+
+    int hits = 0;
+    for (int count : playerHitCounts) {
+        hits += count;
+    }
+    if (hits > 0) {
+        playerHealth -= hits;
+        if (playerHealth <= 0) {
+            gameOver = true;
+        }
+    }
+}
+
+//resetuje obych na potrzebe nowego poziomu i zmienia ich status na aktywny
+void Simulation::resetAliens() {
+    aliens.clear();
+    int rows = (level <= 2) ? difficulty.earlyRows : (level <= 4) ? difficulty.middleRows : difficulty.lateRows;
+    int speedIncrement = (level <= 2) ? 0 : (level <= 4) ? 1 : 2;
+
+    alienSpeed = difficulty.baseAlienSpeed + speedIncrement;
+
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            aliens.add(j * 100 + 50, i * 50 + 50);
+        }
+    }
+}
+//losuje który obcy strzeli; jedno losowanie na każdy tick częstotliwości odniesienia, który upłynął w tym ticku
+void Simulation::alienFire(int rolls) {
+    if (aliens.empty()) {
+        return;
+    }
+    for (; rolls > 0; --rolls) {
+        if (rng.nextInt(100) < difficulty.alienFirePercent) {
+            int shooterIndex = rng.nextInt(aliens.size());
+            if (aliens.isAlive(shooterIndex)) {
+                alienBullets.spawn(aliens.getX(shooterIndex) + aliens.getWidth(shooterIndex) / 2 - 2,
+                    aliens.getY(shooterIndex) + aliens.getHeight(shooterIndex), 5, 10);
+            }
+        }
+    }
+}
+
+//zapamiętuje pozycje sprzed ticka, render interpoluje między nimi a obecnymi
+void Simulation::storePreviousPositions() {
+    player.storePosition();
+    aliens.storePositions();
+    playerBullets.storePositions();
+    alienBullets.storePositions();
+}
+
+//format tekstowy stanu gry, używany przez save.txt i nagłówek nagrania
+void Simulation::writeState(std::ostream& out) const {
+    out << "Player " << player.x << " " << player.y << " " << playerHealth << "\n";
+
+    out << "Level " << level << "\n";
+    out << "AlienSpeed " << alienSpeed << "\n";
+    out << "AlienDirection " << alienDirection << "\n";
+
+    out << "Aliens " << aliens.size() << "\n";
+    for (int i = 0; i < aliens.size(); ++i) {
+        out << aliens.getX(i) << " " << aliens.getY(i) << " " << aliens.isAlive(i) << "\n";
+    }
+}
+
+bool Simulation::readState(std::istream& in) {
+    std::string label;
+    int alienCount = 0;
+
+    in >> label >> player.x >> player.y >> playerHealth;
+
+    in >> label >> level;
+    in >> label >> alienSpeed;
+    in >> label >> alienDirection;
+
+    in >> label >> alienCount;
+    if (in.fail() || alienCount < 0) {
+        return false;
+    }
+    aliens.clear();
+    for (int i = 0; i < alienCount; ++i) {
+        int x, y, active;
+        if (!(in >> x >> y >> active)) {
+            return false; // ucięty plik: nie dokładamy obcych ze śmieciowymi pozycjami
+        }
+        aliens.setAlive(aliens.add(x, y), active != 0);
+    }
+    return true;
+}
+//suma kontrolna stanu symulacji (FNV-1a), porównuje nagraną i odtworzoną sesję
+Uint32 Simulation::checksum() const {
+    Uint32 hash = 2166136261u;
+    auto mix = [&hash](int value) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= static_cast<Uint32>(value >> (8 * i)) & 0xFF;
+            hash *= 16777619u;
+        }
+    };
+
+    mix(player.x);
+    mix(player.y);
+    mix(playerHealth);
+    mix(level);
+    mix(score);
+    mix(alienSpeed);
+    mix(alienDirection);
+    for (int i = 0; i < aliens.size(); ++i) {
+        mix(aliens.getX(i));
+        mix(aliens.getY(i));
+        mix(aliens.isAlive(i));
+    }
+    for (int i = 0; i < playerBullets.size(); ++i) {
+        mix(playerBullets.getX(i));
+        mix(playerBullets.getY(i));
+    }
+    for (int i = 0; i < alienBullets.size(); ++i) {
+        mix(alienBullets.getX(i));
+        mix(alienBullets.getY(i));
+    }
+    return hash;
+}
+//dopisuje do kolejki świat gry: gracza, obcych, pociski i paski zdrowia
+void Simulation::render(RenderQueue& queue, float alpha) const {
+    player.render(queue, alpha);
+
+    aliens.render(queue, alpha);
+
+    playerBullets.render(queue, alpha);
+
+    alienBullets.render(queue, alpha);
+
+    SDL_Color red = { 255, 0, 0, 255 };
+    for (int i = 0; i < playerHealth; ++i) {
+        SDL_Rect healthBar = { 10, 50 + (i * 20), 10, 10 };
+        queue.fillRect(healthBar, red, RenderQueue::LAYER_HUD);
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "Player.h"
+#include "AlienStore.h"
+#include "BulletPool.h"
+#include "CollisionGrid.h"
+#include "Difficulty.h"
+#include "InputFrame.h"
+#include "JobSystem.h"
+#include "Random.h"
+#include "RenderQueue.h"
+#include <vector>
+#include <iosfwd>
+#include "SDL.h"
+
+//stan rozgrywki i jej logika bez okna, dźwięku i plików: jeden tick = update()
+//używana przez GameEngine, benchmark i odtwarzanie nagrań
+class Simulation {
+public:
+    Simulation();
+
+    void reset(Uint64 seed);
+    void update(const InputFrame& input);
+    void resetAliens();
+    void storePreviousPositions();
+    void render(RenderQueue& queue, float alpha) const;
+    //z systemem zadań duże fale liczą kroki ticka na wielu wątkach z wynikiem identycznym jak szeregowo; nullptr = szeregowo
+    void setJobSystem(JobSystem* jobSystem);
+
+    void writeState(std::ostream& out) const;
+    bool readState(std::istream& in);
+    Uint32 checksum() const;
+
+    Player player;
+    AlienStore aliens;
+    BulletPool playerBullets;
+    BulletPool alienBullets;
+
+    int playerHealth;
+    int level;
+    int alienSpeed;
+    int alienDirection;
+    int score;
+    bool gameOver;
+    Uint32 tickCount;
+    Random rng;
+    Difficulty difficulty; // nie jest zmieniana przez reset
+    int tickRate;          // ticki na sekundę; nie jest zmieniana przez reset ani zapisywana w stanie
+
+    static constexpr int SCREEN_WIDTH = 800;
+    static constexpr int SCREEN_HEIGHT = 600;
+    static constexpr int REFERENCE_TICK_RATE = 60; // dla niej podane są prędkości (px na tick) i szansa strzału obcych
+    static constexpr int GRID_CELL_SIZE = 64;
+    static constexpr size_t GRID_MIN_PAIRS = 1024; // poniżej tylu par pocisk-obcy siatka się nie opłaca
+    static constexpr int PARALLEL_MIN_ENTITIES = 2048; // mniejszy tick liczy się szybciej na jednym wątku
+    static constexpr int BULLET_GRAIN = 512;
+    static constexpr int ALIEN_GRAIN = 1024;    // wielokrotność 64, jak wymagają zakresy AlienStore
+    static constexpr int COLLISION_GRAIN = 128;
+
+private:
+    //trafienie pocisku gracza znalezione w fazie równoległej, do rozstrzygnięcia w kolejności pocisków
+    struct BulletHit {
+        int bullet;
+        int alien;
+    };
+
+    void forRange(int count, int grain, const JobSystem::RangeWork& work);
+    void movePlayerBullets();
+    void moveAlienBullets();
+    void moveAliens();
+    void collidePlayerBullets();
+    void collideAlienBullets();
+    void alienFire(int rolls);
+    void analyzeAliens(int* activeCount, int* totalCount, int* speed);
+    int stepFor(int perReferenceTick) const;
+
+    CollisionGrid alienGrid;
+    JobSystem* jobs;
+    JobSystem* tickJobs; // jobs w ticku, który się opłaca zrównoleglić, inaczej nullptr
+    std::vector<std::vector<BulletHit>> hitBuffers; // po jednym na wątek systemu zadań
+    std::vector<BulletHit> mergedHits;
+    std::vector<int> playerHitCounts;
+};
+
+#endif
+#pragma once
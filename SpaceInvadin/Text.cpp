@@ -0,0 +1,54 @@
+#include "Text.h"
+
+Text::Text(const GlyphAtlas& atlas, const std::string& message_text, const SDL_Color& color)
+    : _atlas(&atlas), _message_text(message_text), _color(color), _text_rect{ 0, 0, 0, 0 } {
+}
+
+void Text::setText(const std::string& message_text) {
+    if (message_text != _message_text) {
+        _message_text = message_text;
+        _dirty = true;
+    }
+}
+
+void Text::setColor(const SDL_Color& color) {
+    if (color.r != _color.r || color.g != _color.g || color.b != _color.b || color.a != _color.a) {
+        _color = color;
+        _dirty = true;
+    }
+}
+//rysuje zapamiętaną geometrię, przelicza ją tylko po zmianie
+void Text::display(RenderQueue& queue, int x, int y) const {
+    if (x != _text_rect.x || y != _text_rect.y) {
+        _text_rect.x = x;
+        _text_rect.y = y;
+        _dirty = true;
+    }
+    if (_dirty) {
+        rebuild();
+    }
+
+    if (!_indices.empty()) {
+        queue.drawGeometry(_atlas->getTexture(), _vertices.data(), static_cast<int>(_vertices.size()),
+            _indices.data(), static_cast<int>(_indices.size()));
+    }
+}
+
+const SDL_Rect& Text::getRect() const {
+    if (_dirty) {
+        rebuild();
+    }
+    return _text_rect;
+}
+//układa znaki z atlasu, dopóki atlas nie jest wczytany napis zostaje brudny
+void Text::rebuild() const {
+    _vertices.clear();
+    _indices.clear();
+    if (!_atlas->isLoaded()) {
+        return;
+    }
+
+    _atlas->measure(_message_text, &_text_rect.w, &_text_rect.h);
+    _atlas->layout(_message_text, _color, _text_rect.x, _text_rect.y, _vertices, _indices);
+    _dirty = false;
+}
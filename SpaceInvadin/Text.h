@@ -1,20 +1,32 @@
 #pragma once
 
-#include <SDL_ttf.h>
 #include <SDL.h>
 #include <string>
+#include <vector>
+#include "GlyphAtlas.h"
+#include "RenderQueue.h"
 
+//napis trzymany między klatkami, przelicza geometrię tylko gdy zmieni się tekst, kolor lub pozycja
 class Text {
 public:
-    Text(const std::string& font_path, int font_size, const std::string& message_text, const SDL_Color& color);
-    ~Text();
+    Text(const GlyphAtlas& atlas, const std::string& message_text, const SDL_Color& color);
 
-    void display(SDL_Renderer* renderer, int x, int y) const;
+    void setText(const std::string& message_text);
+    void setColor(const SDL_Color& color);
 
-    static SDL_Texture* loadFont(const std::string& font_path, int font_size, const std::string& message_text, const SDL_Color& color, SDL_Renderer* renderer);
+    void display(RenderQueue& queue, int x, int y) const;
+
+    const SDL_Rect& getRect() const;
 
 private:
-    SDL_Texture* _text_texture = nullptr;
-    SDL_Rect _text_rect;
+    void rebuild() const;
+
+    const GlyphAtlas* _atlas;
+    std::string _message_text;
+    SDL_Color _color;
+
+    mutable bool _dirty = true;
+    mutable std::vector<SDL_Vertex> _vertices;
+    mutable std::vector<int> _indices;
+    mutable SDL_Rect _text_rect;
 };
-#pragma once
@@ -0,0 +1,114 @@
+#include "Trace.h"
+#include <algorithm>
+#include <cstdio>
+
+constexpr size_t Tracer::EVENTS_PER_THREAD;
+
+namespace {
+    thread_local void* threadBuffer = nullptr;
+
+    void appendEscaped(std::string& out, const char* text) {
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') {
+                out += '\\';
+            }
+            out += *c;
+        }
+    }
+}
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer()
+    : recording(false) {
+}
+
+void Tracer::setRecording(bool enabled) {
+    recording.store(enabled);
+}
+
+void Tracer::setThreadName(const char* name) {
+    ThreadBuffer* buffer = currentBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->name = name;
+}
+//pełny pierścień nadpisuje najstarsze zdarzenie
+void Tracer::record(const char* name, Uint64 start, Uint64 end) {
+    ThreadBuffer* buffer = currentBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    if (buffer->events.empty()) {
+        buffer->events.resize(EVENTS_PER_THREAD);
+    }
+    TraceEvent& event = buffer->events[buffer->next];
+    event.name = name;
+    event.start = start;
+    event.duration = end - start;
+    buffer->next++;
+    if (buffer->next == EVENTS_PER_THREAD) {
+        buffer->next = 0;
+        buffer->wrapped = true;
+    }
+}
+
+Tracer::ThreadBuffer* Tracer::currentBuffer() {
+    if (!threadBuffer) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers.emplace_back(new ThreadBuffer());
+        buffers.back()->threadId = static_cast<int>(buffers.size());
+        buffers.back()->name = "thread " + std::to_string(buffers.size());
+        threadBuffer = buffers.back().get();
+    }
+    return static_cast<ThreadBuffer*>(threadBuffer);
+}
+//zdarzenia "X" (początek i czas trwania) w mikrosekundach od początku okna, plus nazwy wątków jako metadane "M"
+std::string Tracer::exportJson(double windowSeconds) {
+    double microsPerTick = 1000000.0 / SDL_GetPerformanceFrequency();
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+
+    std::vector<std::vector<TraceEvent>> snapshots(buffers.size());
+    std::vector<std::string> names(buffers.size());
+    Uint64 latestEnd = 0;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        ThreadBuffer& buffer = *buffers[i];
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        names[i] = buffer.name;
+        if (buffer.wrapped) {
+            snapshots[i].assign(buffer.events.begin() + buffer.next, buffer.events.end());
+        }
+        snapshots[i].insert(snapshots[i].end(), buffer.events.begin(), buffer.events.begin() + buffer.next);
+        for (const auto& event : snapshots[i]) {
+            latestEnd = std::max(latestEnd, event.start + event.duration);
+        }
+    }
+    Uint64 windowTicks = static_cast<Uint64>(windowSeconds * SDL_GetPerformanceFrequency());
+    Uint64 windowStart = latestEnd > windowTicks ? latestEnd - windowTicks : 0;
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char number[128];
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        json += first ? "\n" : ",\n";
+        first = false;
+        std::snprintf(number, sizeof(number), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"",
+            buffers[i]->threadId);
+        json += number;
+        appendEscaped(json, names[i].c_str());
+        json += "\"}}";
+
+        for (const auto& event : snapshots[i]) {
+            if (event.start < windowStart) {
+                continue;
+            }
+            json += ",\n{\"name\":\"";
+            appendEscaped(json, event.name);
+            std::snprintf(number, sizeof(number), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                buffers[i]->threadId, (event.start - windowStart) * microsPerTick, event.duration * microsPerTick);
+            json += number;
+        }
+    }
+    json += "\n]}\n";
+    return json;
+}
@@ -0,0 +1,92 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "SDL.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//TRACE_ENABLED=0 usuwa strefy z kodu
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+//zakończona strefa; nazwa musi być literałem, bo jest czytana dopiero przy eksporcie
+struct TraceEvent {
+    const char* name;
+    Uint64 start;
+    Uint64 duration;
+};
+
+//nagrywanie stref do bufora każdego wątku i eksport w formacie trace_event Chrome (Perfetto, chrome://tracing)
+//bufor wątku to pierścień EVENTS_PER_THREAD zdarzeń alokowany przy pierwszej strefie, więc pamięć jest ograniczona,
+//a po zatrzymaniu zostają ostatnie sekundy, np. wokół przycięcia
+class Tracer {
+public:
+    static constexpr size_t EVENTS_PER_THREAD = 1 << 16; // 1.5 MB na wątek
+
+    static Tracer& instance();
+
+    Tracer();
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    void setRecording(bool enabled);
+    bool isRecording() const {
+        return recording.load(std::memory_order_relaxed);
+    }
+
+    void setThreadName(const char* name);
+    void record(const char* name, Uint64 start, Uint64 end);
+
+    //JSON ze zdarzeniami z ostatnich windowSeconds przed najpóźniejszym końcem strefy
+    std::string exportJson(double windowSeconds);
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex; // niezajęty poza eksportem
+        std::vector<TraceEvent> events;
+        size_t next = 0;
+        bool wrapped = false;
+        int threadId = 0;
+        std::string name;
+    };
+
+    ThreadBuffer* currentBuffer();
+
+    std::atomic<bool> recording;
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+//strefa od konstrukcji do końca zakresu; przy wyłączonym nagrywaniu kosztuje jeden odczyt flagi
+class TraceZone {
+public:
+    explicit TraceZone(const char* name)
+        : name(name), start(Tracer::instance().isRecording() ? SDL_GetPerformanceCounter() : 0) {
+    }
+    ~TraceZone() {
+        if (start != 0) {
+            Tracer::instance().record(name, start, SDL_GetPerformanceCounter());
+        }
+    }
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* name;
+    Uint64 start;
+};
+
+#if TRACE_ENABLED
+#define TRACE_ZONE_NAME(line) traceZone##line
+#define TRACE_ZONE_AT(name, line) TraceZone TRACE_ZONE_NAME(line)(name)
+#define TRACE_ZONE(name) TRACE_ZONE_AT(name, __LINE__)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#endif
+
+#endif
+#pragma once
@@ -1,10 +1,36 @@
 #include "GameEngine.h"
+#include "Log.h"
+
+namespace {
+    //inicjalizacja statyczna idzie przed main, więc to najwcześniejszy punkt procesu dostępny bez API systemu
+    const Uint64 processStart = SDL_GetPerformanceCounter();
+}
 
 int main(int argc, char* argv[]) {
-    GameEngine gameEngine;
+    EngineOptions options;
+    if (!parseEngineOptions(argc, argv, &options)) {
+        return 1;
+    }
+
+    std::unique_ptr<LogSink> logSink(new ConsoleLogSink());
+    if (!options.logPath.empty()) {
+        std::unique_ptr<FileLogSink> fileSink(new FileLogSink(options.logPath));
+        if (fileSink->isOpen()) {
+            logSink = std::move(fileSink);
+        }
+        else {
+            SDL_Log("Failed to open log file %s, logging to console", options.logPath.c_str());
+        }
+    }
+    Logger::instance().setLevel(options.logLevel);
+    Logger::instance().start(std::move(logSink));
+
+    GameEngine gameEngine(options, processStart);
     if (gameEngine.initialize()) {
         gameEngine.run();
     }
     gameEngine.cleanup();
+
+    Logger::instance().stop();
     return 0;
 }
@@ -0,0 +1,303 @@
+#include "Simulation.h"
+#include "JobSystem.h"
+#include "Random.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    enum Policy {
+        POLICY_SCRIPTED,
+        POLICY_RANDOM,
+        POLICY_IDLE
+    };
+
+    const char* const POLICY_NAMES[] = { "scripted", "random", "idle" };
+    const Uint64 POLICY_SEED_SALT = 0x9E3779B97F4A7C15ULL; // gracz losowy nie może dzielić ciągu z symulacją
+    const int GAME_GRAIN = 8; // gier w jednym zadaniu; gra trwa tysiące ticków, więc więcej nie trzeba
+
+    //jeden punkt siatki parametrów
+    struct GridPoint {
+        Difficulty difficulty;
+        Policy policy;
+    };
+
+    struct GameResult {
+        Uint32 ticks;
+        int score;
+        int level;
+        bool timedOut; // przerwana po max-ticks zamiast game over
+    };
+
+    bool parsePolicy(const std::string& name, Policy* policy) {
+        for (int i = POLICY_SCRIPTED; i <= POLICY_IDLE; ++i) {
+            if (name == POLICY_NAMES[i]) {
+                *policy = static_cast<Policy>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+    //lista po przecinkach, np. "3,4,5"; każda wartość musi leżeć w [minValue, maxValue]
+    bool parseIntList(const char* text, int minValue, int maxValue, std::vector<int>* values) {
+        values->clear();
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            char* end = nullptr;
+            long value = std::strtol(item.c_str(), &end, 10);
+            if (item.empty() || *end != '\0' || value < minValue || value > maxValue) {
+                return false;
+            }
+            values->push_back(static_cast<int>(value));
+        }
+        return !values->empty();
+    }
+
+    bool parsePolicyList(const char* text, std::vector<Policy>* values) {
+        values->clear();
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            Policy policy;
+            if (!parsePolicy(item, &policy)) {
+                return false;
+            }
+            values->push_back(policy);
+        }
+        return !values->empty();
+    }
+
+    void printUsage() {
+        std::cerr << "Usage: SpaceInvadinBatch [--games N] [--max-ticks N] [--seed N] [--threads N] [--out FILE]" << std::endl
+            << "    [--policy scripted,random,idle] [--early-rows LIST] [--middle-rows LIST] [--late-rows LIST]" << std::endl
+            << "    [--speed LIST] [--fire LIST]" << std::endl
+            << "  every LIST is comma separated, e.g. --fire 3,5,8; the grid is every combination of them" << std::endl
+            << "  rows must be positive, --speed at least 0 and --fire between 0 and 100" << std::endl
+            << "  --games is per grid point, all points play the same seeds" << std::endl;
+    }
+
+    //prosty deterministyczny gracz: strzela co 8 ticków, co sekundę zmienia kierunek
+    InputFrame scriptedInput(Uint32 tick) {
+        InputFrame input;
+        input.buttons |= ((tick / 60) % 2 == 0) ? INPUT_LEFT : INPUT_RIGHT;
+        if (tick % 8 == 0) {
+            input.buttons |= INPUT_FIRE;
+        }
+        return input;
+    }
+    //rozgrywa jedną grę od pierwszego poziomu; symulacja jest tylko resetowana, więc pule i siatka zostają zaalokowane
+    GameResult playGame(Simulation& sim, const GridPoint& point, Uint64 seed, Uint32 maxTicks) {
+        sim.difficulty = point.difficulty;
+        sim.reset(seed);
+
+        // gracz losowy trzyma kierunek przez losową liczbę ticków i strzela średnio co szósty tick
+        Random policyRng(seed ^ POLICY_SEED_SALT);
+        Uint8 heldDirection = 0;
+        int holdTicks = 0;
+
+        while (!sim.gameOver && sim.tickCount < maxTicks) {
+            InputFrame input;
+            switch (point.policy) {
+            case POLICY_SCRIPTED:
+                input = scriptedInput(sim.tickCount);
+                break;
+            case POLICY_RANDOM:
+                if (holdTicks-- <= 0) {
+                    int choice = policyRng.nextInt(3);
+                    heldDirection = (choice == 0) ? INPUT_LEFT : (choice == 1) ? INPUT_RIGHT : 0;
+                    holdTicks = 10 + policyRng.nextInt(50);
+                }
+                input.buttons = heldDirection;
+                if (policyRng.nextInt(6) == 0) {
+                    input.buttons |= INPUT_FIRE;
+                }
+                break;
+            case POLICY_IDLE:
+                break;
+            }
+            sim.update(input);
+        }
+
+        GameResult result;
+        result.ticks = sim.tickCount;
+        result.score = sim.score;
+        result.level = sim.level;
+        result.timedOut = !sim.gameOver;
+        return result;
+    }
+    //jeden wiersz CSV z podsumowaniem gier jednego punktu siatki
+    void writeSummary(std::ostream& out, const GridPoint& point, const GameResult* results, int count) {
+        std::vector<Uint32> ticks(count);
+        double tickSum = 0;
+        double scoreSum = 0;
+        double levelSum = 0;
+        int maxScore = 0;
+        int maxLevel = 0;
+        int timeouts = 0;
+        for (int i = 0; i < count; ++i) {
+            ticks[i] = results[i].ticks;
+            tickSum += results[i].ticks;
+            scoreSum += results[i].score;
+            levelSum += results[i].level;
+            maxScore = std::max(maxScore, results[i].score);
+            maxLevel = std::max(maxLevel, results[i].level);
+            if (results[i].timedOut) {
+                timeouts++;
+            }
+        }
+        std::sort(ticks.begin(), ticks.end());
+
+        const Difficulty& d = point.difficulty;
+        out << POLICY_NAMES[point.policy] << "," << d.earlyRows << "," << d.middleRows << "," << d.lateRows << ","
+            << d.baseAlienSpeed << "," << d.alienFirePercent << "," << count << ","
+            << tickSum / count << "," << ticks[count / 2] << "," << ticks.front() << "," << ticks.back() << ","
+            << scoreSum / count << "," << maxScore << "," << levelSum / count << "," << maxLevel << ","
+            << timeouts << "\n";
+    }
+
+    void discardLog(void* /*userdata*/, int /*category*/, SDL_LogPriority /*priority*/, const char* /*message*/) {
+    }
+}
+//rozgrywa bez okna po --games gier dla każdego punktu siatki trudności i zapisuje podsumowanie punktów jako CSV
+//gry idą równolegle po jednej na wątek; każdy wątek ma własną symulację, a wynik gry zależy tylko od seeda i punktu,
+//więc plik wynikowy jest ten sam przy każdej liczbie wątków
+int main(int argc, char* argv[]) {
+    int gamesPerPoint = 1000;
+    Uint32 maxTicks = 60 * 60 * 10; // 10 minut gry przy 60 tickach na sekundę
+    Uint64 seed = 1;
+    int threads = 0;
+    std::string outPath = "batch_results.csv";
+    std::vector<Policy> policies = { POLICY_SCRIPTED };
+    Difficulty defaults;
+    std::vector<int> earlyRows = { defaults.earlyRows };
+    std::vector<int> middleRows = { defaults.middleRows };
+    std::vector<int> lateRows = { defaults.lateRows };
+    std::vector<int> speeds = { defaults.baseAlienSpeed };
+    std::vector<int> firePercents = { defaults.alienFirePercent };
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool ok = hasValue;
+        if (std::strcmp(arg, "--games") == 0 && hasValue) {
+            gamesPerPoint = std::atoi(argv[++i]);
+            ok = gamesPerPoint > 0;
+        }
+        else if (std::strcmp(arg, "--max-ticks") == 0 && hasValue) {
+            maxTicks = static_cast<Uint32>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(arg, "--out") == 0 && hasValue) {
+            outPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--policy") == 0 && hasValue) {
+            ok = parsePolicyList(argv[++i], &policies);
+        }
+        else if (std::strcmp(arg, "--early-rows") == 0 && hasValue) {
+            ok = parseIntList(argv[++i], 1, INT_MAX, &earlyRows);
+        }
+        else if (std::strcmp(arg, "--middle-rows") == 0 && hasValue) {
+            ok = parseIntList(argv[++i], 1, INT_MAX, &middleRows);
+        }
+        else if (std::strcmp(arg, "--late-rows") == 0 && hasValue) {
+            ok = parseIntList(argv[++i], 1, INT_MAX, &lateRows);
+        }
+        else if (std::strcmp(arg, "--speed") == 0 && hasValue) {
+            ok = parseIntList(argv[++i], 0, INT_MAX, &speeds);
+        }
+        else if (std::strcmp(arg, "--fire") == 0 && hasValue) {
+            ok = parseIntList(argv[++i], 0, 100, &firePercents);
+        }
+        else {
+            ok = false;
+        }
+        if (!ok) {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::vector<GridPoint> grid;
+    for (Policy policy : policies) {
+        for (int early : earlyRows) {
+            for (int middle : middleRows) {
+                for (int late : lateRows) {
+                    for (int speed : speeds) {
+                        for (int fire : firePercents) {
+                            GridPoint point;
+                            point.policy = policy;
+                            point.difficulty.earlyRows = early;
+                            point.difficulty.middleRows = middle;
+                            point.difficulty.lateRows = late;
+                            point.difficulty.baseAlienSpeed = speed;
+                            point.difficulty.alienFirePercent = fire;
+                            grid.push_back(point);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // logi z update() szłyby na konsolę w każdym ticku każdej gry
+    SDL_LogSetOutputFunction(discardLog, nullptr);
+
+    // równolegle idą całe gry, nie kroki ticka: symulacje nie dostają systemu zadań
+    JobSystem jobs(threads);
+    std::vector<std::unique_ptr<Simulation>> simulations;
+    for (int i = 0; i < jobs.getThreadCount(); ++i) {
+        simulations.emplace_back(new Simulation());
+    }
+
+    int totalGames = static_cast<int>(grid.size()) * gamesPerPoint;
+    std::vector<GameResult> results(totalGames);
+    auto start = std::chrono::steady_clock::now();
+    jobs.parallelFor(totalGames, GAME_GRAIN, [&](int begin, int end, int worker) {
+        Simulation& sim = *simulations[worker];
+        for (int game = begin; game < end; ++game) {
+            results[game] = playGame(sim, grid[game / gamesPerPoint], seed + game % gamesPerPoint, maxTicks);
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ostringstream csv;
+    csv << "policy,early_rows,middle_rows,late_rows,alien_speed,alien_fire_percent,games,"
+        << "mean_survival_ticks,p50_survival_ticks,min_survival_ticks,max_survival_ticks,"
+        << "mean_score,max_score,mean_level,max_level,timeouts\n";
+    Uint64 totalTicks = 0;
+    for (size_t i = 0; i < grid.size(); ++i) {
+        const GameResult* pointResults = results.data() + i * gamesPerPoint;
+        writeSummary(csv, grid[i], pointResults, gamesPerPoint);
+        for (int game = 0; game < gamesPerPoint; ++game) {
+            totalTicks += pointResults[game].ticks;
+        }
+    }
+
+    std::ofstream out(outPath);
+    if (!out) {
+        std::cerr << "Failed to open " << outPath << std::endl;
+        return 1;
+    }
+    out << csv.str();
+
+    std::cout << "Played " << totalGames << " games (" << grid.size() << " grid points, " << totalTicks << " ticks) in "
+        << seconds << " s on " << jobs.getThreadCount() << " threads: "
+        << static_cast<long long>(seconds > 0 ? totalGames * 60.0 / seconds : 0) << " games/min, "
+        << static_cast<long long>(seconds > 0 ? totalTicks / seconds : 0) << " ticks/s" << std::endl
+        << "Results written to " << outPath << std::endl;
+    return 0;
+}
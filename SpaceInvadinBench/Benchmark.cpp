@@ -0,0 +1,200 @@
+#include "Scenario.h"
+#include "NullRenderer.h"
+#include "RenderQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct PhaseStats {
+        double mean;
+        long long p50;
+        long long p99;
+        long long max;
+    };
+
+    long long nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    PhaseStats summarize(std::vector<long long>& samples) {
+        PhaseStats stats = { 0.0, 0, 0, 0 };
+        if (samples.empty()) {
+            return stats;
+        }
+        std::sort(samples.begin(), samples.end());
+        long long total = 0;
+        for (long long sample : samples) {
+            total += sample;
+        }
+        stats.mean = static_cast<double>(total) / samples.size();
+        stats.p50 = samples[samples.size() / 2];
+        stats.p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        stats.max = samples.back();
+        return stats;
+    }
+
+    void writePhase(std::ostream& out, const char* name, std::vector<long long>& samples, bool last) {
+        PhaseStats stats = summarize(samples);
+        out << "        \"" << name << "\": { \"mean_ns\": " << static_cast<long long>(stats.mean)
+            << ", \"p50_ns\": " << stats.p50 << ", \"p99_ns\": " << stats.p99
+            << ", \"max_ns\": " << stats.max << " }" << (last ? "\n" : ",\n");
+    }
+
+    const char* const SIMD_NAMES[] = { "scalar", "sse2", "avx2" };
+
+    bool parseSimdLevel(const char* name, SimdLevel* level) {
+        for (int i = SIMD_SCALAR; i <= SIMD_AVX2; ++i) {
+            if (std::strcmp(SIMD_NAMES[i], name) == 0) {
+                *level = static_cast<SimdLevel>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void discardLog(void* /*userdata*/, int /*category*/, SDL_LogPriority /*priority*/, const char* /*message*/) {
+    }
+}
+//uruchamia symulację bez okna dla każdego scenariusza i wypisuje czasy faz jako JSON
+int main(int argc, char* argv[]) {
+    int ticks = 10000;
+    int warmup = 200;
+    Uint64 seed = 1;
+    std::string onlyScenario;
+    std::string outPath;
+    SimdLevel simd = AlienStore::detectSimdLevel();
+    int threads = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--ticks") == 0 && i + 1 < argc) {
+            ticks = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(arg, "--warmup") == 0 && i + 1 < argc) {
+            warmup = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(arg, "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--scenario") == 0 && i + 1 < argc) {
+            onlyScenario = argv[++i];
+        }
+        else if (std::strcmp(arg, "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--simd") == 0 && i + 1 < argc && parseSimdLevel(argv[i + 1], &simd)) {
+            ++i;
+        }
+        else if (std::strcmp(arg, "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        }
+        else {
+            std::cerr << "Usage: SpaceInvadinBench [--ticks N] [--warmup N] [--seed N] [--scenario NAME] [--simd scalar|sse2|avx2] [--threads N] [--out FILE]\n"
+                << "Scenarios:";
+            for (const auto& scenario : scenarioPresets()) {
+                std::cerr << " " << scenario.name;
+            }
+            std::cerr << std::endl;
+            return 1;
+        }
+    }
+
+    // logi z update() szłyby na konsolę w każdym ticku i zagłuszyłyby pomiar
+    SDL_LogSetOutputFunction(discardLog, nullptr);
+
+    // 1 = bez systemu zadań, 0 = wszystkie rdzenie; sumy kontrolne mają wyjść te same przy każdej liczbie wątków
+    std::unique_ptr<JobSystem> jobs;
+    if (threads != 1) {
+        jobs.reset(new JobSystem(threads));
+    }
+
+    NullRenderer renderer;
+    RenderQueue queue;
+    renderer.initialize("SpaceInvadinBench", Simulation::SCREEN_WIDTH, Simulation::SCREEN_HEIGHT);
+
+    std::ostringstream json;
+    json << "{\n  \"ticks\": " << ticks << ",\n  \"warmup\": " << warmup << ",\n  \"seed\": " << seed
+        << ",\n  \"simd\": \"" << SIMD_NAMES[std::min(simd, AlienStore::detectSimdLevel())] << "\""
+        << ",\n  \"threads\": " << (jobs ? jobs->getThreadCount() : 1)
+        << ",\n  \"scenarios\": [\n";
+
+    bool first = true;
+    for (const auto& scenario : scenarioPresets()) {
+        if (!onlyScenario.empty() && onlyScenario != scenario.name) {
+            continue;
+        }
+
+        Simulation sim;
+        sim.aliens.setSimdLevel(simd);
+        sim.playerBullets.setSimdLevel(simd);
+        sim.alienBullets.setSimdLevel(simd);
+        sim.setJobSystem(jobs.get());
+        Random spawnRng(seed ^ 0xB5ULL);
+        applyScenario(scenario, sim, seed);
+
+        std::vector<long long> updateTimes;
+        std::vector<long long> renderTimes;
+        std::vector<long long> frameTimes;
+        updateTimes.reserve(ticks);
+        renderTimes.reserve(ticks);
+        frameTimes.reserve(ticks);
+        long long aliensSeen = 0;
+        long long bulletsSeen = 0;
+
+        for (int t = 0; t < warmup + ticks; ++t) {
+            maintainScenario(scenario, sim, spawnRng, seed);
+            InputFrame input = scriptedInput(sim.tickCount);
+
+            long long start = nowNs();
+            sim.storePreviousPositions();
+            sim.update(input);
+            long long updated = nowNs();
+            sim.render(queue, 1.0f);
+            queue.flush(renderer);
+            renderer.present();
+            long long rendered = nowNs();
+
+            if (t >= warmup) {
+                updateTimes.push_back(updated - start);
+                renderTimes.push_back(rendered - updated);
+                frameTimes.push_back(rendered - start);
+                aliensSeen += sim.aliens.size();
+                bulletsSeen += sim.playerBullets.size() + sim.alienBullets.size();
+            }
+        }
+
+        json << (first ? "" : ",\n") << "    {\n      \"name\": \"" << scenario.name << "\",\n"
+            << "      \"mean_aliens\": " << (ticks > 0 ? aliensSeen / ticks : 0) << ",\n"
+            << "      \"mean_bullets\": " << (ticks > 0 ? bulletsSeen / ticks : 0) << ",\n"
+            << "      \"checksum\": \"" << std::hex << sim.checksum() << std::dec << "\",\n"
+            << "      \"phases\": {\n";
+        writePhase(json, "update", updateTimes, false);
+        writePhase(json, "render", renderTimes, false);
+        writePhase(json, "frame", frameTimes, true);
+        json << "      }\n    }";
+        first = false;
+    }
+    json << "\n  ]\n}\n";
+
+    if (outPath.empty()) {
+        std::cout << json.str();
+    }
+    else {
+        std::ofstream out(outPath);
+        if (!out) {
+            std::cerr << "Failed to open " << outPath << std::endl;
+            return 1;
+        }
+        out << json.str();
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "Scenario.h"
+#include <algorithm>
+
+const std::vector<Scenario>& scenarioPresets() {
+    static const std::vector<Scenario> presets = {
+        { "default_wave", 1, 0, 0, 0, 0, 0, 0, false, 0, BulletPool::OVERFLOW_DROP_NEWEST },
+        { "late_level", 5, 0, 0, 0, 0, 0, 0, false, 0, BulletPool::OVERFLOW_DROP_NEWEST },
+        { "swarm_2k", 1, 40, 50, 18, 10, 500, 500, true, 0, BulletPool::OVERFLOW_DROP_NEWEST },
+        { "swarm_8k", 1, 100, 80, 7, 6, 2000, 2000, true, 0, BulletPool::OVERFLOW_DROP_NEWEST },
+        { "bullet_storm", 1, 20, 10, 36, 24, 5000, 5000, true, 0, BulletPool::OVERFLOW_DROP_NEWEST },
+        // zadanych pocisków jest dwa razy więcej niż miejsca, więc co tick połowa spawnów zwalnia najstarszy pocisk
+        { "bullet_recycle", 1, 20, 10, 36, 24, 4096, 4096, true, 2048, BulletPool::OVERFLOW_RECYCLE_OLDEST },
+    };
+    return presets;
+}
+
+namespace {
+    void buildFormation(const Scenario& scenario, Simulation& sim) {
+        sim.aliens.clear();
+        sim.aliens.reserve(scenario.alienColumns * scenario.alienRows);
+        for (int i = 0; i < scenario.alienRows; ++i) {
+            for (int j = 0; j < scenario.alienColumns; ++j) {
+                sim.aliens.add(j * scenario.alienSpacingX + 10, i * scenario.alienSpacingY + 40);
+            }
+        }
+        sim.alienDirection = 1;
+    }
+}
+//ustawia symulację na start scenariusza
+void applyScenario(const Scenario& scenario, Simulation& sim, Uint64 seed) {
+    // domyślnie pule mieszczą zadaną liczbę pocisków i te wystrzelone w bieżącym ticku
+    sim.playerBullets.setCapacity(scenario.bulletCapacity > 0 ? scenario.bulletCapacity :
+        std::max(BulletPool::DEFAULT_CAPACITY, scenario.playerBullets + 64));
+    sim.alienBullets.setCapacity(scenario.bulletCapacity > 0 ? scenario.bulletCapacity :
+        std::max(BulletPool::DEFAULT_CAPACITY, scenario.alienBullets + 64));
+    sim.playerBullets.setOverflowPolicy(scenario.overflow);
+    sim.alienBullets.setOverflowPolicy(scenario.overflow);
+    sim.reset(seed);
+    sim.level = scenario.level;
+    sim.resetAliens();
+    if (scenario.alienColumns > 0 && scenario.alienRows > 0) {
+        buildFormation(scenario, sim);
+    }
+    sim.storePreviousPositions();
+}
+//poza pomiarem: dokłada brakujące do zadanej liczby pociski i wznawia grę po game over lub wybiciu formacji;
+//przy mniejszej pojemności pula wcale nie dojdzie do zadanej liczby, więc brakujące są liczone raz przed dokładaniem
+void maintainScenario(const Scenario& scenario, Simulation& sim, Random& spawnRng, Uint64 seed) {
+    if (sim.gameOver) {
+        applyScenario(scenario, sim, seed + sim.tickCount);
+        return;
+    }
+
+    if (scenario.endless) {
+        sim.playerHealth = 3;
+        if (sim.aliens.aliveCount() * 2 < scenario.alienColumns * scenario.alienRows) {
+            buildFormation(scenario, sim);
+        }
+    }
+
+    int missingPlayer = scenario.playerBullets - sim.playerBullets.size();
+    for (int i = 0; i < missingPlayer; ++i) {
+        sim.playerBullets.spawn(spawnRng.nextInt(Simulation::SCREEN_WIDTH), Simulation::SCREEN_HEIGHT - 80 - spawnRng.nextInt(200), 5, 10);
+    }
+    int missingAlien = scenario.alienBullets - sim.alienBullets.size();
+    for (int i = 0; i < missingAlien; ++i) {
+        sim.alienBullets.spawn(spawnRng.nextInt(Simulation::SCREEN_WIDTH), spawnRng.nextInt(Simulation::SCREEN_HEIGHT / 2), 5, 10);
+    }
+}
+//prosty deterministyczny gracz: strzela co 8 ticków, co sekundę zmienia kierunek
+InputFrame scriptedInput(Uint32 tick) {
+    InputFrame input;
+    input.buttons |= ((tick / 60) % 2 == 0) ? INPUT_LEFT : INPUT_RIGHT;
+    if (tick % 8 == 0) {
+        input.buttons |= INPUT_FIRE;
+    }
+    return input;
+}
@@ -0,0 +1,29 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include "Simulation.h"
+#include <vector>
+
+//preset stanu gry do benchmarku; zerowe wymiary formacji = formacja z resetAliens dla danego poziomu
+struct Scenario {
+    const char* name;
+    int level;
+    int alienColumns;
+    int alienRows;
+    int alienSpacingX;
+    int alienSpacingY;
+    int playerBullets;  // tyle pocisków gracza jest dokładanych przed każdym tickiem
+    int alienBullets;
+    bool endless;       // zdrowie gracza i formacja są odnawiane przed każdym tickiem
+    int bulletCapacity; // pojemność każdej puli pocisków, 0 = tyle, ile zadanych pocisków, z zapasem
+    BulletPool::OverflowPolicy overflow;
+};
+
+const std::vector<Scenario>& scenarioPresets();
+
+void applyScenario(const Scenario& scenario, Simulation& sim, Uint64 seed);
+void maintainScenario(const Scenario& scenario, Simulation& sim, Random& spawnRng, Uint64 seed);
+InputFrame scriptedInput(Uint32 tick);
+
+#endif
+#pragma once
@@ -0,0 +1,69 @@
+#include "AssetPack.h"
+#include "AtomicFile.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+    void printUsage() {
+        std::cerr << "Usage: SpaceInvadinPack OUTPUT.pak FILE..." << std::endl
+            << "  each FILE is stored under its path as given, with '/' separators" << std::endl
+            << "  e.g. SpaceInvadinPack assets.pak res/arial.ttf" << std::endl;
+    }
+
+    bool readWholeFile(const std::string& filename, std::vector<Uint8>* bytes) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        bytes->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return !file.bad();
+    }
+}
+//pakuje podane pliki do archiwum i od razu otwiera wynik tak jak gra, żeby wykryć błąd przed wydaniem
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    std::string output = argv[1];
+
+    std::vector<AssetSource> assets;
+    size_t totalBytes = 0;
+    for (int i = 2; i < argc; ++i) {
+        AssetSource asset;
+        asset.name = argv[i];
+        for (char& c : asset.name) {
+            if (c == '\\') {
+                c = '/';
+            }
+        }
+        if (!readWholeFile(argv[i], &asset.bytes)) {
+            std::cerr << "Cannot read " << argv[i] << std::endl;
+            return 1;
+        }
+        totalBytes += asset.bytes.size();
+        assets.push_back(std::move(asset));
+    }
+
+    std::vector<Uint8> pack;
+    if (!encodeAssetPack(std::move(assets), &pack)) {
+        std::cerr << "Duplicate or invalid asset names" << std::endl;
+        return 1;
+    }
+    if (!writeFileAtomic(output, pack.data(), pack.size())) {
+        std::cerr << "Cannot write " << output << std::endl;
+        return 1;
+    }
+
+    AssetPack check;
+    if (!check.open(output)) {
+        std::cerr << "Written pack " << output << " does not load" << std::endl;
+        return 1;
+    }
+    std::cout << output << ": " << check.getCount() << " assets, " << totalBytes << " bytes of data, "
+        << pack.size() << " bytes total" << std::endl;
+    return 0;
+}